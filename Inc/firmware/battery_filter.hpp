@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+// Two-stage moving average. The readings are averaged in blocks of BlockSize
+// samples and the output is the mean of the last BlockCount block averages.
+// The block sums are recomputed from scratch, so no rounding error can build
+// up over time.
+template <uint16_t BlockSize, uint16_t BlockCount>
+class DecimatingAverageFilter {
+ public:
+  float update(float value) {
+    block_sum_ += value;
+    ++block_cnt_;
+
+    if (block_cnt_ == BlockSize) {
+      blocks_[block_idx_] = block_sum_ / static_cast<float>(BlockSize);
+      block_idx_ = (block_idx_ + 1) % BlockCount;
+      if (blocks_filled_ < BlockCount) ++blocks_filled_;
+      block_sum_ = 0.0F;
+      block_cnt_ = 0;
+
+      float sum = 0.0F;
+      for (uint16_t i = 0; i < blocks_filled_; ++i) sum += blocks_[i];
+      output_ = sum / static_cast<float>(blocks_filled_);
+    } else if (blocks_filled_ == 0) {
+      // Not enough data for a single block yet
+      output_ = block_sum_ / static_cast<float>(block_cnt_);
+    }
+
+    return output_;
+  }
+
+ private:
+  float blocks_[BlockCount];
+  float block_sum_ = 0.0F;
+  float output_ = 0.0F;
+  uint16_t block_cnt_ = 0;
+  uint16_t block_idx_ = 0;
+  uint16_t blocks_filled_ = 0;
+};
+
+// Exponential moving average with a time constant of TimeConstant samples.
+template <uint16_t TimeConstant>
+class EmaFilter {
+ public:
+  float update(float value) {
+    if (!initialized_) {
+      output_ = value;
+      initialized_ = true;
+    } else {
+      output_ += (value - output_) * ALPHA;
+    }
+    return output_;
+  }
+
+ private:
+  static constexpr float ALPHA = 1.0F / static_cast<float>(TimeConstant);
+
+  float output_ = 0.0F;
+  bool initialized_ = false;
+};
\ No newline at end of file
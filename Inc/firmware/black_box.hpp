@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Compact snapshot of the drive state taken on a single update() tick. The
+// wheels are in the order of firmware/wheel_states (FL, RL, FR, RR).
+struct BlackBoxRecord {
+  uint32_t time;        // micros() time of the encoder latch
+  int16_t encoder[4];   // count change since the previous tick, in subticks
+  int16_t pwm_duty[4];  // 0.01 %
+  uint16_t current[4];  // mA
+  int16_t gyro[3];      // mrad/s
+  uint16_t battery;     // mV
+};
+
+enum class BlackBoxTrigger : uint8_t { NONE, SERVICE, FAULT, OVERCURRENT };
+
+// Ring buffer holding the records of the last Size ticks. After a trigger it
+// keeps recording for PostTrigger more ticks and then freezes, so that it
+// holds the moments both before and after the event until the main loop has
+// read it out and re-armed it. record() must only be called from update(),
+// trigger() can be called from any context and the rest from the main loop.
+template <uint16_t Size, uint16_t PostTrigger>
+class BlackBox {
+  static_assert(PostTrigger < Size,
+                "The post-trigger part must be shorter than the buffer");
+
+ public:
+  void record(const BlackBoxRecord& record) {
+    if (frozen_.load(std::memory_order_acquire)) return;
+
+    records_[head_] = record;
+    head_ = (head_ + 1) % Size;
+    if (count_ < Size) ++count_;
+
+    if (trigger_.load(std::memory_order_relaxed) == BlackBoxTrigger::NONE)
+      return;
+
+    if (!triggered_) {
+      triggered_ = true;
+      remaining_ = PostTrigger;
+    }
+    if (remaining_ == 0) {
+      frozen_.store(true, std::memory_order_release);
+    } else {
+      --remaining_;
+    }
+  }
+
+  // Only the first trigger after re-arming counts, returns false for the rest
+  bool trigger(BlackBoxTrigger cause) {
+    BlackBoxTrigger expected = BlackBoxTrigger::NONE;
+    return trigger_.compare_exchange_strong(expected, cause,
+                                            std::memory_order_relaxed);
+  }
+
+  bool frozen() const { return frozen_.load(std::memory_order_acquire); }
+
+  // Contents of the frozen buffer, the records are indexed oldest first
+  BlackBoxTrigger cause() const {
+    return trigger_.load(std::memory_order_relaxed);
+  }
+  uint16_t size() const { return count_; }
+  uint16_t triggerIndex() const { return count_ - 1 - PostTrigger; }
+  const BlackBoxRecord& at(uint16_t index) const {
+    return records_[(head_ + Size - count_ + index) % Size];
+  }
+
+  // Discards the frozen records and starts recording again
+  void rearm() {
+    head_ = 0;
+    count_ = 0;
+    triggered_ = false;
+    trigger_.store(BlackBoxTrigger::NONE, std::memory_order_relaxed);
+    frozen_.store(false, std::memory_order_release);
+  }
+
+ private:
+  BlackBoxRecord records_[Size];
+  uint16_t head_ = 0;
+  uint16_t count_ = 0;
+
+  std::atomic<BlackBoxTrigger> trigger_{BlackBoxTrigger::NONE};
+  std::atomic<bool> frozen_{false};
+  // Set by record() once it has seen the trigger
+  bool triggered_ = false;
+  uint16_t remaining_ = 0;
+};
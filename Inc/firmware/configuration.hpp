@@ -1,44 +1,156 @@
 #pragma once
 
+#include "adc.h"
 #include "i2c.h"
 #include "main.h"
 #include "mainf.h"
+#include "tim.h"
 #include "usart.h"
 
 #include "diff_drive_lib/robot_controller.hpp"
 
+#include "firmware/battery_filter.hpp"
 #include "firmware/hal_compat.hpp"
 #include "firmware/motor_controller.hpp"
 
+// The drive model can be fixed with the FIRMWARE_DRIVE_DIFF or
+// FIRMWARE_DRIVE_MECANUM build flag, which leaves the other controller and its
+// odometry topic out of the firmware. Without either flag, both are built in
+// and the firmware/mecanum_wheels parameter selects one at startup.
+#if defined(FIRMWARE_DRIVE_DIFF) && defined(FIRMWARE_DRIVE_MECANUM)
+#error "FIRMWARE_DRIVE_DIFF and FIRMWARE_DRIVE_MECANUM are mutually exclusive"
+#endif
+
 // UART used for rosserial communication
 static UART_HandleTypeDef& ROSSERIAL_UART = huart1;
 
+// The baud rate rosserial starts with after reset and falls back to on errors
+const uint32_t ROSSERIAL_DEFAULT_BAUD_RATE = 250000;
+
+// Baud rates which can be requested through firmware/set_baud_rate. All of
+// them are exact divisions of the 84 MHz USART1 clock.
+const uint32_t ROSSERIAL_BAUD_RATES[] = {250000, 500000, 1000000, 2000000};
+
+// Time (in milliseconds) in which the host has to confirm a new baud rate
+// through firmware/confirm_baud_rate. The same timeout applies to a lost
+// connection at a non-default baud rate.
+const uint32_t BAUD_RATE_FALLBACK_TIMEOUT = 5000;
+
 // I2C used for IMU communication
 static I2C_HandleTypeDef& IMU_I2C = hi2c1;
 
+// Timer which calls the update() function. It is clocked at 1 MHz.
+static TIM_HandleTypeDef& UPDATE_TIM = htim11;
+
+// ADC used for battery voltage and motor current measurements. The conversions
+// are triggered by TIM1 in the middle of every PWM period and ADC_OVERSAMPLING
+// consecutive readings are averaged into adc_buff, which gives a fresh value
+// every millisecond.
+static ADC_HandleTypeDef& MEASUREMENTS_ADC = hadc1;
+
 // The timer CCR value corresponding to 100% PWM duty cycle
 const uint16_t PWM_RANGE = 1000;
 
-// Number of encoder readings to remember when estimating the wheel velocity
-const uint32_t ENCODER_BUFFER_SIZE = 10;
-
-// Number of battery voltage readings to average
-const uint32_t BATTERY_BUFFER_SIZE = 3000;
+// Timers generating the motor PWM signals
+static TIM_TypeDef* const PWM_TIMERS[] = {TIM1, TIM9};
+
+// The time span (in milliseconds) of encoder readings used when estimating the
+// wheel velocity
+const uint16_t VELOCITY_WINDOW_PERIOD = 20;
+
+// The encoders are sampled on every SysTick (1 kHz) and the time of each count
+// change is recorded. Between the edges, the position reported to the wheel
+// controllers is extrapolated with the speed measured from the edge interval,
+// with a resolution of 1/ENCODER_SUBTICKS of a count. This way the velocity
+// estimate follows the edge period at low speeds, where only a few counts fall
+// into the window. The encoder resolution and PID gains are scaled to match.
+// Setting it to 1 disables the interpolation.
+const int32_t ENCODER_SUBTICKS = 16;
+
+// Time (in milliseconds) without encoder edges after which the wheel is
+// considered stopped
+const uint32_t ENCODER_EDGE_TIMEOUT = 500;
+
+// Filter used for the averaged battery voltage. Both variants average over
+// roughly the last 30 seconds of readings.
+using BatteryFilter = DecimatingAverageFilter<100, 30>;
+// using BatteryFilter = EmaFilter<3000>;
+
+// Flash sector holding the cached parameters. The firmware image has to end
+// below it (see board_upload.maximum_size in platformio.ini).
+const uint32_t PARAMS_FLASH_SECTOR = FLASH_SECTOR_5;
+const uint32_t PARAMS_FLASH_ADDRESS = 0x08020000;
+const uint32_t PARAMS_FLASH_SIZE = 128 * 1024;
 
 // Informative LED GPIO
 const GPIO LED = {LED_GPIO_Port, LED_Pin};
 
-// The period (in milliseconds) between calls to the update() function
-const uint16_t UPDATE_PERIOD = 10;
-
-// The periods (in number of calls to the update() function), at which different
-// data is publihed on the ROS topics
-const uint8_t BATTERY_PUB_PERIOD = 10;
-const uint8_t JOINTS_PUB_PERIOD = 5;
-const uint8_t ODOM_PUB_PERIOD = 5;
-const uint8_t IMU_PUB_PERIOD = 1;
-
-// Raw value of the Battery ADC
+// The default period (in milliseconds) between calls to the update() function.
+// It can be shortened with the firmware/control_frequency parameter to any
+// divisor of this value.
+const uint16_t DEFAULT_UPDATE_PERIOD = 10;
+
+// Maximum delay (in microseconds) between the update timer event and the start
+// of the update() call, above which the tick is counted as late
+const uint32_t UPDATE_LATENESS_LIMIT = 500;
+
+// Timeout (in milliseconds) of the independent watchdog. It is fed by loop(),
+// but only if update() has completed a tick since the last feed.
+const uint32_t WATCHDOG_TIMEOUT = 500;
+
+// Watchdog timeout (in milliseconds) used while erasing the parameter flash
+// sector, which stalls the CPU for over a second
+const uint32_t WATCHDOG_BLOCKING_TIMEOUT = 30000;
+
+// Timeout (in milliseconds) of each parameter request made by loop(). It has to
+// stay well below WATCHDOG_TIMEOUT.
+const int PARAMS_FETCH_TIMEOUT = 200;
+
+// Number of requests made by loop() for a single parameter before the fetch is
+// abandoned and the firmware stays with the cached parameters
+const uint8_t PARAMS_FETCH_ATTEMPTS = 5;
+
+// Time (in milliseconds) between a reset request and the reset, which lets the
+// service response reach the host
+const uint32_t RESET_DELAY = 1000;
+
+// The periods (in milliseconds), at which different data is published on the
+// ROS topics. All of them must be multiples of DEFAULT_UPDATE_PERIOD.
+const uint16_t BATTERY_PUB_PERIOD = 100;
+const uint16_t JOINTS_PUB_PERIOD = 50;
+const uint16_t ODOM_PUB_PERIOD = 50;
+const uint16_t IMU_PUB_PERIOD = 10;
+const uint16_t STATE_PUB_PERIOD = 50;
+
+// The periods (in milliseconds) of the battery filter updates (the filter
+// assumes 100 Hz) and of LED blinking
+const uint16_t BATTERY_FILTER_PERIOD = 10;
+const uint16_t LED_LOW_BATTERY_PERIOD = 100;
+const uint16_t LED_DISCONNECTED_PERIOD = 500;
+
+// Number of (decimated) IMU samples sent in a single firmware/imu_batch message
+const uint8_t IMU_BATCH_SIZE = 10;
+
+// Number of messages of each type that can wait in the queue between the
+// update() interrupt and the main loop before new ones start to be dropped
+const uint8_t PUBLISH_QUEUE_SIZE = 16;
+const uint8_t IMU_BATCH_QUEUE_SIZE = 32;
+
+// Number of update() ticks kept in the black box and how many of them are
+// recorded after the trigger
+const uint16_t BLACK_BOX_SIZE = 256;
+const uint16_t BLACK_BOX_POST_TRIGGER = 64;
+
+// Winding current (in Amperes) of any motor which triggers the black box
+const float BLACK_BOX_OVERCURRENT = 2.0F;
+
+// Number of records in a single firmware/black_box message and the period (in
+// milliseconds) between the messages, which keeps the read-out from taking
+// over the serial link
+const uint16_t BLACK_BOX_CHUNK_SIZE = 8;
+const uint16_t BLACK_BOX_CHUNK_PERIOD = 50;
+
+// Averaged raw value of the Battery ADC
 static volatile uint16_t& BATTERY_ADC = adc_buff[4];
 
 // How much Volts per precision of Battery ADC
@@ -49,13 +161,22 @@ const float BATTERY_ADC_TO_VOLTAGE = 32.0F / 4095.0F;
 // 0-2.5 A range, 12 bit precision
 const float VPROPI_ADC_TO_CURRENT = 2.5F / 4095.0F;
 
+// Highest winding current (in Amperes) the current loop regulates to. Kept
+// below the end of the VPROPI range, where the reading saturates and a higher
+// current could not be told apart.
+const float CURRENT_SENSE_RANGE = 2.4F;
+
+// Change of the duty cycle ceiling (in %) per Ampere of the current error on
+// each run of the current loop, which follows the 1 kHz adc_buff updates
+const float CURRENT_LOOP_GAIN = 2.0F;
+
 // Motor driver configurations
 const MotorConfiguration MOT_A_CONFIG = {
     .nsleep = {H4_NSLEEP_GPIO_Port, H4_NSLEEP_Pin},
     .phase = {H4_PHASE_GPIO_Port, H4_PHASE_Pin},
     .mode = {H4_MODE_GPIO_Port, H4_MODE_Pin},
     .fault = {H4_FAULT_GPIO_Port, H4_FAULT_Pin},
-    .enc_cnt = &TIM5->CNT,
+    .enc_tim = TIM5,
     .pwm_ccr = &TIM1->CCR4,
     .vpropi_adc = &adc_buff[3],
     .reverse_polarity = false,
@@ -66,7 +187,7 @@ const MotorConfiguration MOT_B_CONFIG = {
     .phase = {H3_PHASE_GPIO_Port, H3_PHASE_Pin},
     .mode = {H3_MODE_GPIO_Port, H3_MODE_Pin},
     .fault = {H3_FAULT_GPIO_Port, H3_FAULT_Pin},
-    .enc_cnt = &TIM4->CNT,
+    .enc_tim = TIM4,
     .pwm_ccr = &TIM9->CCR2,
     .vpropi_adc = &adc_buff[2],
     .reverse_polarity = false,
@@ -77,7 +198,7 @@ const MotorConfiguration MOT_C_CONFIG = {
     .phase = {H1_PHASE_GPIO_Port, H1_PHASE_Pin},
     .mode = {H1_MODE_GPIO_Port, H1_MODE_Pin},
     .fault = {H1_FAULT_GPIO_Port, H1_FAULT_Pin},
-    .enc_cnt = &TIM3->CNT,
+    .enc_tim = TIM3,
     .pwm_ccr = &TIM1->CCR1,
     .vpropi_adc = &adc_buff[0],
     .reverse_polarity = true,
@@ -88,7 +209,7 @@ const MotorConfiguration MOT_D_CONFIG = {
     .phase = {H2_PHASE_GPIO_Port, H2_PHASE_Pin},
     .mode = {H2_MODE_GPIO_Port, H2_MODE_Pin},
     .fault = {H2_FAULT_GPIO_Port, H2_FAULT_Pin},
-    .enc_cnt = &TIM2->CNT,
+    .enc_tim = TIM2,
     .pwm_ccr = &TIM9->CCR1,
     .vpropi_adc = &adc_buff[1],
     .reverse_polarity = true,
@@ -104,24 +225,28 @@ const diff_drive_lib::RobotConfiguration ROBOT_CONFIG = {
         {
             .motor = MotC,
             .op_mode = diff_drive_lib::WheelOperationMode::VELOCITY,
-            .velocity_rolling_window_size = 10,
+            .velocity_rolling_window_size =
+                VELOCITY_WINDOW_PERIOD / DEFAULT_UPDATE_PERIOD,
         },
     .wheel_RL_conf =
         {
             .motor = MotD,
             .op_mode = diff_drive_lib::WheelOperationMode::VELOCITY,
-            .velocity_rolling_window_size = 10,
+            .velocity_rolling_window_size =
+                VELOCITY_WINDOW_PERIOD / DEFAULT_UPDATE_PERIOD,
         },
     .wheel_FR_conf =
         {
             .motor = MotA,
             .op_mode = diff_drive_lib::WheelOperationMode::VELOCITY,
-            .velocity_rolling_window_size = 10,
+            .velocity_rolling_window_size =
+                VELOCITY_WINDOW_PERIOD / DEFAULT_UPDATE_PERIOD,
         },
     .wheel_RR_conf =
         {
             .motor = MotB,
             .op_mode = diff_drive_lib::WheelOperationMode::VELOCITY,
-            .velocity_rolling_window_size = 10,
+            .velocity_rolling_window_size =
+                VELOCITY_WINDOW_PERIOD / DEFAULT_UPDATE_PERIOD,
         },
 };
\ No newline at end of file
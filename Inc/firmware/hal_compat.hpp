@@ -10,26 +10,100 @@ struct GPIO {
   uint16_t pin;
 };
 
+// The GPIO functions write the BSRR register directly, which sets or resets
+// the pins atomically with a single store. For the GPIO constants, the port
+// address and the pin mask are folded in at compile time.
 inline void gpio_set(const GPIO& gpio) {
-  HAL_GPIO_WritePin(gpio.port, gpio.pin, GPIO_PIN_SET);
+  gpio.port->BSRR = gpio.pin;
 }
 
 inline void gpio_reset(const GPIO& gpio) {
-  HAL_GPIO_WritePin(gpio.port, gpio.pin, GPIO_PIN_RESET);
+  gpio.port->BSRR = static_cast<uint32_t>(gpio.pin) << 16U;
 }
 
 inline void gpio_toggle(const GPIO& gpio) {
-  HAL_GPIO_TogglePin(gpio.port, gpio.pin);
+  const uint32_t odr = gpio.port->ODR;
+  gpio.port->BSRR = ((odr & gpio.pin) << 16U) | (~odr & gpio.pin);
+}
+
+inline bool gpio_read(const GPIO& gpio) {
+  return (gpio.port->IDR & gpio.pin) != 0;
+}
+
+// Enables the DWT cycle counter used as a free-running timestamp
+inline void cycle_counter_init() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+inline uint32_t cycles() {
+  return DWT->CYCCNT;
 }
 
 inline uint32_t time() {
   return HAL_GetTick();
 }
 
+// Time (in microseconds since the start) interpolated within the millisecond
+// tick with the SysTick counter. Wraps around together with time() * 1000.
+inline uint32_t micros() {
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  uint32_t ms = HAL_GetTick();
+  const uint32_t val = SysTick->VAL;
+  // The counter has already reloaded, but the tick is yet to be incremented
+  if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && val > SysTick->LOAD / 2) ++ms;
+  __set_PRIMASK(primask);
+
+  const uint32_t load = SysTick->LOAD + 1;
+  return ms * 1000 + (load - 1 - val) * 1000 / load;
+}
+
 inline void reset() {
   NVIC_SystemReset();
 }
 
+// Returns the cause of the last reset and clears the reset flags
+inline const char* reset_cause() {
+  const uint32_t csr = RCC->CSR;
+  RCC->CSR |= RCC_CSR_RMVF;
+  if (csr & RCC_CSR_IWDGRSTF) return "watchdog";
+  if (csr & RCC_CSR_WWDGRSTF) return "window watchdog";
+  if (csr & RCC_CSR_LPWRRSTF) return "low-power";
+  if (csr & RCC_CSR_SFTRSTF) return "software";
+  if (csr & RCC_CSR_PORRSTF) return "power-on";
+  if (csr & RCC_CSR_BORRSTF) return "brown-out";
+  if (csr & RCC_CSR_PINRSTF) return "reset pin";
+  return "unknown";
+}
+
+// Starts the independent watchdog or changes its timeout (in milliseconds, up
+// to about 32 seconds). The watchdog is clocked from the ~32 kHz LSI and stops
+// while the core is halted by the debugger.
+inline void watchdog_init(uint32_t timeout_ms) {
+  uint32_t prescaler = 0;  // divides the LSI by 4 << prescaler
+  uint32_t reload = timeout_ms * 32 / 4;
+  while (reload > IWDG_RLR_RL && prescaler < 6) {
+    ++prescaler;
+    reload /= 2;
+  }
+  if (reload > IWDG_RLR_RL) reload = IWDG_RLR_RL;
+
+  __HAL_DBGMCU_FREEZE_IWDG();
+  IWDG->KR = 0xCCCC;  // Start, does nothing if already running
+  IWDG->KR = 0x5555;  // Unlock the PR and RLR registers
+  while (IWDG->SR != 0) continue;
+  IWDG->PR = prescaler;
+  IWDG->RLR = reload;
+  while (IWDG->SR != 0) continue;
+  IWDG->KR = 0xAAAA;  // Reload the counter with the new value
+}
+
+inline void watchdog_feed() {
+  IWDG->KR = 0xAAAA;
+}
+
 inline void delay(uint32_t delay_ms) {
   HAL_Delay(delay_ms);
 }
\ No newline at end of file
@@ -5,18 +5,81 @@
 
 #include <ICM42605.hpp>
 
+struct ImuSample {
+  float temp;        // temperature
+  float ax, ay, az;  // accelerometer data
+  float gx, gy, gz;  // gyroscope data
+  uint32_t time;     // micros() time of the measurement
+};
+
 class ImuReceiver {
  public:
+  // Maximum number of FIFO samples picked up by a single update() call.
+  // At 1 kHz ODR the sensor produces 10 samples between the updates, the
+  // extra packets let the FIFO drain after a delayed update.
+  static constexpr uint8_t MAX_SAMPLES = 12;
+
+  // Time between two consecutive FIFO samples (1 kHz ODR)
+  static constexpr uint32_t SAMPLE_PERIOD_US = 1000;
+
   explicit ImuReceiver(I2C_HandleTypeDef* i2c) : icm_(i2c) {}
 
   void init();
-  void update();
 
+  // Picks up the samples from the previously started FIFO transfer (if it has
+  // completed) and starts a new one. Never waits on the I2C bus.
+  // Returns true if the data fields were updated.
+  bool update();
+
+  void readCompleteCallback() { icm_.readCompleteCallback(); }
+  void readErrorCallback() { icm_.readErrorCallback(); }
+
+  // Has to be called on the data-ready interrupt with the current micros()
+  // time. Each FIFO sample is then timestamped with the interrupt that
+  // signalled it. Without the interrupts, the samples are timestamped as if the
+  // newest one was taken right before the FIFO transfer.
+  void dataReadyCallback(uint32_t time_us) {
+    const uint32_t count = data_ready_count_;
+    data_ready_times_[count % READY_TIMES_SIZE] = time_us;
+    data_ready_time_ = time_us;
+    data_ready_count_ = count + 1;
+  }
+
+  // Average of the samples picked up by the last update() call
   float temp;        // temperature
   float ax, ay, az;  // accelerometer data
   float gx, gy, gz;  // gyroscope data
+  uint32_t time;     // micros() time of the middle of the samples
+
+  // All samples picked up by the last update() call, oldest first
+  ImuSample samples[MAX_SAMPLES];
+  uint8_t sample_count = 0;
 
  private:
+  // Number of the latest data-ready interrupt times kept, a power of two so
+  // that the indices stay continuous when the counter wraps
+  static constexpr uint32_t READY_TIMES_SIZE = 32;
+
+  void convertSample(const int16_t* data, ImuSample& sample) const;
+  void stampSamples();
+  void startRead();
+
   ICM42605 icm_;
-  float ares_, gres_;
+  float accel_scale_;  // raw value to m/s^2
+  float gyro_scale_;   // raw value to rad/s
+  int32_t raw_sum_[7];
+  uint8_t fifo_buffer_[MAX_SAMPLES * ICM42605_FIFO_PACKET_SIZE];
+
+  volatile uint32_t data_ready_times_[READY_TIMES_SIZE] = {};
+  volatile uint32_t data_ready_time_ = 0;
+  volatile uint32_t data_ready_count_ = 0;
+  // Number of the samples picked up so far, which is also the number of the
+  // data-ready interrupt that signalled the next sample in the FIFO
+  uint32_t consumed_count_ = 0;
+
+  // Time of the newest sample in the FIFO when the pending transfer was
+  // started and the sample period measured from the data-ready interrupts
+  uint32_t read_time_ = 0;
+  uint32_t read_count_ = 0;
+  uint32_t sample_period_ = SAMPLE_PERIOD_US;
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Single-value mailbox passing the latest item from the main loop to an
+// interrupt. post() must only be called from the thread context and take()
+// from an interrupt which can preempt it. The item is written to the slot the
+// interrupt is not reading from and published with a single atomic store, so
+// the interrupt never sees a partially written item.
+template <typename T>
+class Mailbox {
+ public:
+  void post(const T& item) {
+    const uint8_t idx = (state_.load(std::memory_order_relaxed) & SLOT) ^ SLOT;
+    slots_[idx] = item;
+    state_.store(idx | FULL, std::memory_order_release);
+  }
+
+  bool take(T& item) {
+    const uint8_t state = state_.load(std::memory_order_acquire);
+    if (!(state & FULL)) return false;
+    item = slots_[state & SLOT];
+    state_.store(state & SLOT, std::memory_order_relaxed);
+    return true;
+  }
+
+ private:
+  static constexpr uint8_t SLOT = 0x01;
+  static constexpr uint8_t FULL = 0x02;
+
+  T slots_[2];
+  std::atomic<uint8_t> state_{0};
+};
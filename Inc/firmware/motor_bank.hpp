@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+#include "firmware/motor_controller.hpp"
+
+// Groups the motor controllers, so that the hardware of all the motors is
+// accessed together once per control tick. latch() samples all the encoder
+// counts at the same instant before the controllers run, and commit() applies
+// all the duty cycles requested during the tick afterwards.
+class MotorBank {
+ public:
+  static constexpr uint8_t MOTOR_COUNT = 4;
+  static constexpr uint8_t MAX_PWM_TIMERS = 2;
+
+  MotorBank(MotorController *const (&motors)[MOTOR_COUNT],
+            TIM_TypeDef *const (&pwm_timers)[MAX_PWM_TIMERS]);
+
+  void latch();
+  void commit();
+
+  void sleep();
+  void wake();
+
+  // Drives all the PWM outputs to zero at once. The next commit() applies the
+  // requested duty cycles again.
+  void stop();
+
+  // Sets the winding current limit of all the motors, 0 disables it
+  void setCurrentLimit(float limit);
+
+  // Runs the current loops of all the motors. Has to be called on every
+  // update of the VPROPI readings in adc_buff. The duty cycles limited by the
+  // loops are written outside the UDIS bracket of commit(), so they are not
+  // guaranteed to update on the same PWM period on both timers.
+  void updateCurrentLoop();
+
+  // Forwards the update event of an encoder timer to its motor controller
+  void encoderOverflowCallback(TIM_TypeDef *tim);
+
+  // Forwards the EXTI event of a FAULT pin to its motor controller
+  void faultCallback(uint16_t pin);
+
+ private:
+  MotorController *motors_[MOTOR_COUNT];
+  TIM_TypeDef *pwm_timers_[MAX_PWM_TIMERS];
+
+  // Distinct ports of the PHASE pins and the index of the port of each motor
+  GPIO_TypeDef *phase_ports_[MOTOR_COUNT];
+  uint8_t phase_port_index_[MOTOR_COUNT];
+  uint8_t phase_port_count_ = 0;
+};
@@ -8,7 +8,7 @@
 
 struct MotorConfiguration {
   GPIO nsleep, phase, mode, fault;
-  volatile uint32_t *enc_cnt;
+  TIM_TypeDef *enc_tim;
   volatile uint32_t *pwm_ccr;
   volatile uint16_t *vpropi_adc;
   bool reverse_polarity;
@@ -16,19 +16,105 @@ struct MotorConfiguration {
 
 class MotorController : public diff_drive_lib::MotorControllerInterface {
  public:
-  MotorController(const MotorConfiguration &config) : config_(config){};
+  MotorController(const MotorConfiguration &config);
 
   void init() override;
+
+  // Puts the driver in the low-power sleep mode or wakes it up. The driver
+  // stays asleep through init() calls.
+  void sleep();
+  void wake();
+
+  // The duty cycle is applied by the next MotorBank::commit() call
   void setPWMDutyCycle(float pwm_duty) override;
+  // Drives the motor with the given winding current (in Amperes) instead of
+  // a fixed duty cycle. The sign selects the direction and the duty cycle
+  // never exceeds pwm_duty_limit. The current is limited to
+  // CURRENT_SENSE_RANGE and 0 turns the output off. The output starts from
+  // zero and rises with the current loop. Ends with the next setPWMDutyCycle()
+  // call. Safe to call from the main loop.
+  void setTargetCurrent(float current, float pwm_duty_limit);
+  // Limit (in Amperes) of the winding current in every mode, 0 disables it
+  void setCurrentLimit(float limit) { current_limit_ = limit; }
   float getPWMDutyCycle() override;
+  // Returns the count (in subticks) latched by the last MotorBank::latch()
+  // call. It wraps around modulo 2^32, so only the differences between the
+  // counts are meaningful.
   int32_t getEncoderCnt() override;
   void resetEncoderCnt() override;
   float getWindingCurrent() override;
 
+  // Reads the encoder timer and timestamps the count changes. Has to be called
+  // at a steady rate, much higher than the rate of getEncoderCnt() calls.
+  void sampleEncoder();
+
+  // Has to be called on each update event of a 16-bit encoder timer
+  void encoderOverflowCallback();
+
+  // Runs the current loop on a fresh VPROPI reading. It lowers the duty cycle
+  // applied by MotorBank::commit() for as long as the winding current exceeds
+  // the limit or the target current.
+  void updateCurrentLoop();
+
+  // Has to be called on the falling edge of the FAULT pin. Cuts the PWM output
+  // until MotorBank::commit() sees the driver recovered.
+  void faultCallback();
+
+  uint32_t getFaultCount() const { return fault_count_; }
+  // Time (in milliseconds since the start) of the last fault
+  uint32_t getLastFaultTime() const { return fault_time_; }
+
  private:
+  friend class MotorBank;
+
+  // Extrapolates the encoder count to the given time and latches it. Has to be
+  // called with interrupts disabled.
+  void latchEncoderCnt(uint32_t now);
+
+  void setRequestedDuty(float pwm_duty);
+
+  // Output value of the last MotorBank::commit() call, reduced by the current
+  // loop and zeroed while a reversal is held. Has to be called with
+  // interrupts disabled.
+  uint32_t limitedCcrValue() const;
+
   MotorConfiguration config_;
 
   float pwm_duty_ = 0.0F;
-  uint8_t ticks_prev_quarter_ = 0;
+
+  volatile bool asleep_ = false;
+
+  // The 32-bit encoder timers are read directly, the wraps of the 16-bit ones
+  // are accumulated in ticks_offset_
+  const int32_t ticks_wrap_;
   int32_t ticks_offset_ = 0;
+
+  // Output state waiting for MotorBank::commit()
+  uint32_t pwm_ccr_value_ = 0;
+  bool phase_ = false;
+
+  // State of the PHASE pin. It changes immediately, while the preloaded CCR
+  // only at the next PWM period, so a reversal is held with the output off
+  // for one commit.
+  bool output_phase_ = false;
+  bool reversal_hold_ = false;
+
+  // Current loop state. The duty cycle ceiling (in %) is lowered while the
+  // current is above the limit and rises back once it falls below.
+  uint32_t committed_ccr_value_ = 0;
+  float current_limit_ = 0.0F;
+  float target_current_ = 0.0F;
+  bool current_mode_ = false;
+  float duty_ceiling_ = 100.0F;
+
+  int32_t latched_cnt_ = 0;
+
+  volatile bool fault_ = false;
+  volatile uint32_t fault_count_ = 0;
+  volatile uint32_t fault_time_ = 0;
+
+  // State of the encoder at the last observed count change
+  int32_t edge_ticks_ = 0;
+  uint32_t edge_time_ = 0;
+  float edge_velocity_ = 0.0F;  // counts per CPU cycle
 };
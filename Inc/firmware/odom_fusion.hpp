@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+#include "diff_drive_lib/robot_controller.hpp"
+
+#include "firmware/imu_receiver.hpp"
+
+// Complementary filter combining the wheel odometry with the gyroscope. The
+// heading is integrated from every 1 kHz gyroscope sample, while the wheels
+// provide the linear velocities and, whenever the robot stands still, the
+// reference for the slowly drifting gyroscope bias.
+class OdomFusion {
+ public:
+  void reset();
+
+  // Advances the estimate by the IMU samples picked up since the last call,
+  // using the current velocities from the wheel odometry
+  void update(const ImuSample* samples, uint8_t sample_count,
+              const diff_drive_lib::Odom& odom);
+
+  // Has to be called on every control tick with the micros() time of the
+  // odometry. If no gyroscope samples have come for a while, e.g. with the
+  // IMU missing or its reads failing, the estimate is advanced with the yaw
+  // rate of the wheel odometry instead. The samples from the time covered
+  // this way are skipped once they arrive.
+  void updateWheels(const diff_drive_lib::Odom& odom, uint32_t time_us);
+
+  // Fused estimate in the same frames as the wheel odometry
+  float velocity_lin_x = 0.0F;
+  float velocity_lin_y = 0.0F;
+  float velocity_ang = 0.0F;
+  float pose_x = 0.0F;
+  float pose_y = 0.0F;
+  float pose_yaw = 0.0F;
+
+ private:
+  void advance(float heading_change, float dt);
+
+  float gyro_bias_ = 0.0F;
+
+  // micros() time up to which the estimate has been advanced
+  uint32_t time_ = 0;
+  bool time_valid_ = false;
+  // Set while the estimate is advanced by updateWheels()
+  bool gyro_timed_out_ = false;
+};
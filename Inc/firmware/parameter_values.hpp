@@ -0,0 +1,65 @@
+#pragma once
+
+#include <diff_drive_lib/robot_controller.hpp>
+
+// Values of the firmware parameters with their defaults. Kept apart from
+// Parameters, which fetches and stores them, so that they can be used without
+// rosserial.
+struct ParameterValues : diff_drive_lib::RobotParams {
+  // Override inherited parameters
+  ParameterValues() {
+    // Motor
+    wheel_encoder_resolution = 878.4F;
+    wheel_torque_constant = 1.17647F;
+    wheel_pid_p = 0.0F;
+    wheel_pid_i = 0.005F;
+    wheel_pid_d = 0.0F;
+    wheel_pwm_duty_limit = 100.0F;
+
+    robot_wheel_radius = 0.0625F;
+    robot_wheel_separation = 0.358F;
+    robot_wheel_base = 0.3052F;
+    robot_angular_velocity_multiplier = 1.76F;
+    robot_input_timeout = 500;
+  }
+
+  // Limit (in Amperes) of the winding current of each motor, enforced by the
+  // current loop in all the wheel modes. 0 disables the limit. Higher values
+  // than CURRENT_SENSE_RANGE, the end of the measurable range, are lowered to
+  // it when loaded.
+  float wheel_current_limit = 0.0F;
+
+  float battery_min_voltage = 10.0;
+
+  bool mecanum_wheels = false;
+
+  // Whether the mecanum controller is used. Constant in the builds with the
+  // drive model fixed by a build flag, which then ignore mecanum_wheels.
+  bool mecanumWheels() const {
+#if defined(FIRMWARE_DRIVE_MECANUM)
+    return true;
+#elif defined(FIRMWARE_DRIVE_DIFF)
+    return false;
+#else
+    return mecanum_wheels;
+#endif
+  }
+
+  // Frequency (in Hz) of the wheel controller updates. The update period in
+  // milliseconds has to divide DEFAULT_UPDATE_PERIOD, so the valid values are
+  // 100, 200, 500 and 1000.
+  int control_frequency = 100;
+
+  // Number of 1 kHz IMU samples averaged into a single firmware/imu_batch
+  // entry. 0 disables the topic.
+  int imu_batch_decimation = 0;
+
+  // Replaces the battery, wheel odometry and wheel states topics with a single
+  // fused state frame. 0 - disabled, 1 - firmware/state, 2 - quantized
+  // firmware/state_quantized.
+  int state_frame = 0;
+
+  // Publishes the wheel odometry fused with the gyroscope on
+  // firmware/odom_fused
+  bool odom_fusion = false;
+};
@@ -1,30 +1,35 @@
 #pragma once
 
-#include <ros.h>
+#include <leo_msgs/SetParams.h>
 
-#include <diff_drive_lib/robot_controller.hpp>
+#include "firmware/parameter_values.hpp"
+#include "firmware/ros.hpp"
 
-struct Parameters : diff_drive_lib::RobotParams {
-  // Override inherited parameters
-  Parameters() {
-    // Motor
-    wheel_encoder_resolution = 878.4F;
-    wheel_torque_constant = 1.17647F;
-    wheel_pid_p = 0.0F;
-    wheel_pid_i = 0.005F;
-    wheel_pid_d = 0.0F;
-    wheel_pwm_duty_limit = 100.0F;
+struct Parameters : ParameterValues {
+  // Number of the parameters fetched from the ROS parameter server
+  static constexpr uint8_t COUNT = 18;
 
-    robot_wheel_radius = 0.0625F;
-    robot_wheel_separation = 0.358F;
-    robot_wheel_base = 0.3052F;
-    robot_angular_velocity_multiplier = 1.76F;
-    robot_input_timeout = 500;
-  }
+  // Fetches all the parameters from the ROS parameter server, the ones which
+  // do not arrive keep their current values
+  void load(ros::NodeHandle &nh);
+  // Fetches only the parameter number index (below COUNT), waiting for at
+  // most timeout milliseconds. Returns false if the parameter has not arrived.
+  bool load(ros::NodeHandle &nh, uint8_t index, int timeout);
+  void load(const leo_msgs::SetParamsRequest &req);
 
-  float battery_min_voltage = 10.0;
+  // Whether the parameters differ in the values which can only be applied on
+  // the start of the firmware
+  bool needsRestart(const Parameters &other) const;
 
-  bool mecanum_wheels = false;
+  // Restores the last parameter set saved in the flash. Returns false if there
+  // is no valid one.
+  bool loadCached();
 
-  void load(ros::NodeHandle &nh);
+  // Saves the parameters in the flash, unless they are already the last saved
+  // set. Returns true if a new set was written.
+  bool saveCached() const;
+
+  // Whether saveCached() has to erase the flash sector first, which stalls
+  // the CPU, interrupts included, for over a second
+  bool saveNeedsErase() const;
 };
@@ -0,0 +1,93 @@
+#pragma once
+
+// Execution time measurements of the firmware stages, based on the DWT cycle
+// counter. Enabled with the FIRMWARE_PROFILING build flag, otherwise the macros
+// below expand to nothing.
+
+#ifdef FIRMWARE_PROFILING
+
+#include <cstddef>
+#include <cstdint>
+
+#include "firmware/hal_compat.hpp"
+
+enum ProfileStage : uint8_t {
+  PROFILE_UPDATE,
+  PROFILE_BATTERY,
+  PROFILE_CONTROLLER,
+  PROFILE_WHEEL_STATES,
+  PROFILE_ODOM,
+  PROFILE_IMU,
+  PROFILE_STATE,
+  PROFILE_BLACK_BOX,
+  PROFILE_SPIN,
+  PROFILE_PUB_BATTERY,
+  PROFILE_PUB_ODOM,
+  PROFILE_PUB_WHEEL_STATES,
+  PROFILE_PUB_IMU,
+  PROFILE_PUB_IMU_BATCH,
+  PROFILE_PUB_STATE,
+  PROFILE_PUB_BLACK_BOX,
+  PROFILE_STAGE_COUNT,
+};
+
+// Statistics of the durations (in CPU cycles) of a single stage
+struct ProfileStats {
+  void add(uint32_t cycles) {
+    if (cycles < min) min = cycles;
+    if (cycles > max) max = cycles;
+    sum += cycles;
+    ++count;
+  }
+
+  uint32_t min = UINT32_MAX;
+  uint32_t max = 0;
+  uint64_t sum = 0;
+  uint32_t count = 0;
+};
+
+class Profiler {
+ public:
+  void add(ProfileStage stage, uint32_t cycles) {
+    stats_[stage].add(cycles);
+    if (stage == PROFILE_UPDATE && cycles > update_budget_) ++overruns_;
+  }
+
+  // An update() call taking longer than this is counted as an overrun
+  void setUpdateBudget(uint32_t cycles) { update_budget_ = cycles; }
+
+  // Writes the statistics as "stage min/mean/max" entries to the buffer and
+  // starts collecting new ones
+  void report(char* buf, size_t size);
+
+ private:
+  ProfileStats stats_[PROFILE_STAGE_COUNT];
+  uint32_t update_budget_ = UINT32_MAX;
+  uint32_t overruns_ = 0;
+};
+
+extern Profiler profiler;
+
+// Measures the time until the end of the enclosing scope
+class ProfileScope {
+ public:
+  explicit ProfileScope(ProfileStage stage) : stage_(stage), start_(cycles()) {}
+  ~ProfileScope() { profiler.add(stage_, cycles() - start_); }
+
+ private:
+  ProfileStage stage_;
+  uint32_t start_;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(stage) \
+  ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(stage)
+#define PROFILE_SET_UPDATE_BUDGET(cycles) profiler.setUpdateBudget(cycles)
+
+#else
+
+#define PROFILE_SCOPE(stage)
+#define PROFILE_SET_UPDATE_BUDGET(cycles)
+
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <ros/node_handle.h>
+
+#include "firmware/rosserial_hardware.hpp"
+
+namespace ros {
+typedef NodeHandle_<RosserialHardware> NodeHandle;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+#include "stm32f4xx_hal.h"
+
+// rosserial hardware layer for a UART with DMA. Incoming bytes are collected
+// by a circular DMA transfer and the IDLE line interrupt tells when a burst of
+// them (usually a complete frame) has arrived. Outgoing frames are appended to
+// one of two buffers while the other one is being transmitted, so writes do not
+// wait for the previous transfer and frames written in a burst leave in a
+// single DMA transfer.
+class RosserialHardware {
+ public:
+  static constexpr uint16_t RX_BUFFER_SIZE = 512;
+  static constexpr uint16_t TX_BUFFER_SIZE = 1024;
+
+  void setUart(UART_HandleTypeDef *huart) { huart_ = huart; }
+
+  // Interface used by ros::NodeHandle_
+  void init();
+  int read();
+  void write(const uint8_t *data, int length);
+  unsigned long time() { return HAL_GetTick(); }
+
+  // Has to be called from HAL_UART_TxCpltCallback
+  void TxCpltCallback();
+
+  // Has to be called from the UART interrupt handler on the IDLE line event
+  void IdleCallback() { rx_idle_ = true; }
+
+  // Whether all the written data has been sent. The receiver keeps the UART
+  // busy all the time, so HAL_UART_GetState() cannot tell this.
+  bool txIdle() const { return !tx_busy_ && tx_fill_length_ == 0; }
+
+  // Returns true once after new data has been received. Lets the main loop
+  // handle incoming frames between publishing messages.
+  bool dataReceived() {
+    if (!rx_idle_) return false;
+    rx_idle_ = false;
+    return true;
+  }
+
+ private:
+  // Starts sending the filled buffer. Interrupts have to be disabled.
+  bool startTransfer();
+
+  UART_HandleTypeDef *huart_ = nullptr;
+
+  uint8_t rx_buffer_[RX_BUFFER_SIZE];
+  uint16_t rx_tail_ = 0;
+  volatile bool rx_idle_ = false;
+
+  uint8_t tx_buffers_[2][TX_BUFFER_SIZE];
+  volatile uint16_t tx_fill_length_ = 0;
+  uint8_t tx_fill_idx_ = 0;
+  volatile bool tx_busy_ = false;
+  volatile bool tx_writing_ = false;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer single-consumer ring buffer used to pass data from
+// the update() interrupt to the main loop. push() must only be called from one
+// context and pop() from the other. Pushing to a full queue never blocks, the
+// item is dropped and counted instead.
+template <typename T, uint8_t Size>
+class SpscQueue {
+  static_assert(Size > 1 && Size <= 128 && (Size & (Size - 1)) == 0,
+                "Queue size must be a power of 2 not greater than 128");
+
+ public:
+  bool push(const T& item) {
+    const uint8_t head = head_.load(std::memory_order_relaxed);
+    const uint8_t tail = tail_.load(std::memory_order_acquire);
+    if (static_cast<uint8_t>(head - tail) == Size) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    buffer_[head % Size] = item;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& item) {
+    const uint8_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) return false;
+    item = buffer_[tail % Size];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Number of items that did not fit in the queue since the start
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  T buffer_[Size];
+  // Free-running indices, the difference is the number of queued items
+  std::atomic<uint8_t> head_{0};
+  std::atomic<uint8_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
@@ -0,0 +1,330 @@
+#ifndef _ROS_leo_msgs_BlackBoxChunk_h
+#define _ROS_leo_msgs_BlackBoxChunk_h
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "ros/msg.h"
+#include "ros/time.h"
+
+namespace leo_msgs
+{
+
+  class BlackBoxChunk : public ros::Msg
+  {
+    public:
+      typedef ros::Time _stamp_type;
+      _stamp_type stamp;
+      typedef uint8_t _trigger_type;
+      _trigger_type trigger;
+      typedef uint16_t _trigger_index_type;
+      _trigger_index_type trigger_index;
+      typedef uint16_t _index_type;
+      _index_type index;
+      typedef uint16_t _total_type;
+      _total_type total;
+      uint32_t time_offset_length;
+      typedef int32_t _time_offset_type;
+      _time_offset_type st_time_offset;
+      _time_offset_type * time_offset;
+      uint32_t encoder_delta_length;
+      typedef int16_t _encoder_delta_type;
+      _encoder_delta_type st_encoder_delta;
+      _encoder_delta_type * encoder_delta;
+      uint32_t pwm_duty_length;
+      typedef int16_t _pwm_duty_type;
+      _pwm_duty_type st_pwm_duty;
+      _pwm_duty_type * pwm_duty;
+      uint32_t current_length;
+      typedef uint16_t _current_type;
+      _current_type st_current;
+      _current_type * current;
+      uint32_t gyro_length;
+      typedef int16_t _gyro_type;
+      _gyro_type st_gyro;
+      _gyro_type * gyro;
+      uint32_t battery_length;
+      typedef uint16_t _battery_type;
+      _battery_type st_battery;
+      _battery_type * battery;
+
+    BlackBoxChunk():
+      stamp(),
+      trigger(0),
+      trigger_index(0),
+      index(0),
+      total(0),
+      time_offset_length(0),
+      st_time_offset(),
+      time_offset(nullptr),
+      encoder_delta_length(0),
+      st_encoder_delta(),
+      encoder_delta(nullptr),
+      pwm_duty_length(0),
+      st_pwm_duty(),
+      pwm_duty(nullptr),
+      current_length(0),
+      st_current(),
+      current(nullptr),
+      gyro_length(0),
+      st_gyro(),
+      gyro(nullptr),
+      battery_length(0),
+      st_battery(),
+      battery(nullptr)
+    {
+    }
+
+    virtual int serialize(unsigned char *outbuffer) const override
+    {
+      int offset = 0;
+      *(outbuffer + offset + 0) = (this->stamp.sec >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->stamp.sec >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->stamp.sec >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->stamp.sec >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->stamp.sec);
+      *(outbuffer + offset + 0) = (this->stamp.nsec >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->stamp.nsec >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->stamp.nsec >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->stamp.nsec >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->stamp.nsec);
+      *(outbuffer + offset + 0) = (this->trigger >> (8 * 0)) & 0xFF;
+      offset += sizeof(this->trigger);
+      *(outbuffer + offset + 0) = (this->trigger_index >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->trigger_index >> (8 * 1)) & 0xFF;
+      offset += sizeof(this->trigger_index);
+      *(outbuffer + offset + 0) = (this->index >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->index >> (8 * 1)) & 0xFF;
+      offset += sizeof(this->index);
+      *(outbuffer + offset + 0) = (this->total >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->total >> (8 * 1)) & 0xFF;
+      offset += sizeof(this->total);
+      *(outbuffer + offset + 0) = (this->time_offset_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->time_offset_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->time_offset_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->time_offset_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->time_offset_length);
+      for( uint32_t i = 0; i < time_offset_length; i++){
+      union {
+        int32_t real;
+        uint32_t base;
+      } u_time_offseti;
+      u_time_offseti.real = this->time_offset[i];
+      *(outbuffer + offset + 0) = (u_time_offseti.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_time_offseti.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_time_offseti.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_time_offseti.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->time_offset[i]);
+      }
+      *(outbuffer + offset + 0) = (this->encoder_delta_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->encoder_delta_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->encoder_delta_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->encoder_delta_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->encoder_delta_length);
+      for( uint32_t i = 0; i < encoder_delta_length; i++){
+      union {
+        int16_t real;
+        uint16_t base;
+      } u_encoder_deltai;
+      u_encoder_deltai.real = this->encoder_delta[i];
+      *(outbuffer + offset + 0) = (u_encoder_deltai.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_encoder_deltai.base >> (8 * 1)) & 0xFF;
+      offset += sizeof(this->encoder_delta[i]);
+      }
+      *(outbuffer + offset + 0) = (this->pwm_duty_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->pwm_duty_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->pwm_duty_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->pwm_duty_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->pwm_duty_length);
+      for( uint32_t i = 0; i < pwm_duty_length; i++){
+      union {
+        int16_t real;
+        uint16_t base;
+      } u_pwm_dutyi;
+      u_pwm_dutyi.real = this->pwm_duty[i];
+      *(outbuffer + offset + 0) = (u_pwm_dutyi.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_pwm_dutyi.base >> (8 * 1)) & 0xFF;
+      offset += sizeof(this->pwm_duty[i]);
+      }
+      *(outbuffer + offset + 0) = (this->current_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->current_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->current_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->current_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->current_length);
+      for( uint32_t i = 0; i < current_length; i++){
+      *(outbuffer + offset + 0) = (this->current[i] >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->current[i] >> (8 * 1)) & 0xFF;
+      offset += sizeof(this->current[i]);
+      }
+      *(outbuffer + offset + 0) = (this->gyro_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->gyro_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->gyro_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->gyro_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->gyro_length);
+      for( uint32_t i = 0; i < gyro_length; i++){
+      union {
+        int16_t real;
+        uint16_t base;
+      } u_gyroi;
+      u_gyroi.real = this->gyro[i];
+      *(outbuffer + offset + 0) = (u_gyroi.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_gyroi.base >> (8 * 1)) & 0xFF;
+      offset += sizeof(this->gyro[i]);
+      }
+      *(outbuffer + offset + 0) = (this->battery_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->battery_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->battery_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->battery_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->battery_length);
+      for( uint32_t i = 0; i < battery_length; i++){
+      *(outbuffer + offset + 0) = (this->battery[i] >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->battery[i] >> (8 * 1)) & 0xFF;
+      offset += sizeof(this->battery[i]);
+      }
+      return offset;
+    }
+
+    virtual int deserialize(unsigned char *inbuffer) override
+    {
+      int offset = 0;
+      this->stamp.sec =  ((uint32_t) (*(inbuffer + offset)));
+      this->stamp.sec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->stamp.sec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      this->stamp.sec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->stamp.sec);
+      this->stamp.nsec =  ((uint32_t) (*(inbuffer + offset)));
+      this->stamp.nsec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->stamp.nsec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      this->stamp.nsec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->stamp.nsec);
+      this->trigger =  ((uint8_t) (*(inbuffer + offset)));
+      offset += sizeof(this->trigger);
+      this->trigger_index =  ((uint16_t) (*(inbuffer + offset)));
+      this->trigger_index |= ((uint16_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      offset += sizeof(this->trigger_index);
+      this->index =  ((uint16_t) (*(inbuffer + offset)));
+      this->index |= ((uint16_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      offset += sizeof(this->index);
+      this->total =  ((uint16_t) (*(inbuffer + offset)));
+      this->total |= ((uint16_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      offset += sizeof(this->total);
+      uint32_t time_offset_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      time_offset_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      time_offset_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      time_offset_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->time_offset_length);
+      if(time_offset_lengthT > time_offset_length)
+        this->time_offset = (int32_t*)realloc(this->time_offset, time_offset_lengthT * sizeof(int32_t));
+      time_offset_length = time_offset_lengthT;
+      for( uint32_t i = 0; i < time_offset_length; i++){
+      union {
+        int32_t real;
+        uint32_t base;
+      } u_st_time_offset;
+      u_st_time_offset.base = 0;
+      u_st_time_offset.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_time_offset.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_st_time_offset.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_st_time_offset.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->st_time_offset = u_st_time_offset.real;
+      offset += sizeof(this->st_time_offset);
+        memcpy( &(this->time_offset[i]), &(this->st_time_offset), sizeof(int32_t));
+      }
+      uint32_t encoder_delta_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      encoder_delta_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      encoder_delta_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      encoder_delta_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->encoder_delta_length);
+      if(encoder_delta_lengthT > encoder_delta_length)
+        this->encoder_delta = (int16_t*)realloc(this->encoder_delta, encoder_delta_lengthT * sizeof(int16_t));
+      encoder_delta_length = encoder_delta_lengthT;
+      for( uint32_t i = 0; i < encoder_delta_length; i++){
+      union {
+        int16_t real;
+        uint16_t base;
+      } u_st_encoder_delta;
+      u_st_encoder_delta.base = 0;
+      u_st_encoder_delta.base |= ((uint16_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_encoder_delta.base |= ((uint16_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->st_encoder_delta = u_st_encoder_delta.real;
+      offset += sizeof(this->st_encoder_delta);
+        memcpy( &(this->encoder_delta[i]), &(this->st_encoder_delta), sizeof(int16_t));
+      }
+      uint32_t pwm_duty_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      pwm_duty_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      pwm_duty_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      pwm_duty_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->pwm_duty_length);
+      if(pwm_duty_lengthT > pwm_duty_length)
+        this->pwm_duty = (int16_t*)realloc(this->pwm_duty, pwm_duty_lengthT * sizeof(int16_t));
+      pwm_duty_length = pwm_duty_lengthT;
+      for( uint32_t i = 0; i < pwm_duty_length; i++){
+      union {
+        int16_t real;
+        uint16_t base;
+      } u_st_pwm_duty;
+      u_st_pwm_duty.base = 0;
+      u_st_pwm_duty.base |= ((uint16_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_pwm_duty.base |= ((uint16_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->st_pwm_duty = u_st_pwm_duty.real;
+      offset += sizeof(this->st_pwm_duty);
+        memcpy( &(this->pwm_duty[i]), &(this->st_pwm_duty), sizeof(int16_t));
+      }
+      uint32_t current_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      current_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      current_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      current_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->current_length);
+      if(current_lengthT > current_length)
+        this->current = (uint16_t*)realloc(this->current, current_lengthT * sizeof(uint16_t));
+      current_length = current_lengthT;
+      for( uint32_t i = 0; i < current_length; i++){
+      this->st_current =  ((uint16_t) (*(inbuffer + offset)));
+      this->st_current |= ((uint16_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      offset += sizeof(this->st_current);
+        memcpy( &(this->current[i]), &(this->st_current), sizeof(uint16_t));
+      }
+      uint32_t gyro_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      gyro_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      gyro_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      gyro_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->gyro_length);
+      if(gyro_lengthT > gyro_length)
+        this->gyro = (int16_t*)realloc(this->gyro, gyro_lengthT * sizeof(int16_t));
+      gyro_length = gyro_lengthT;
+      for( uint32_t i = 0; i < gyro_length; i++){
+      union {
+        int16_t real;
+        uint16_t base;
+      } u_st_gyro;
+      u_st_gyro.base = 0;
+      u_st_gyro.base |= ((uint16_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_gyro.base |= ((uint16_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->st_gyro = u_st_gyro.real;
+      offset += sizeof(this->st_gyro);
+        memcpy( &(this->gyro[i]), &(this->st_gyro), sizeof(int16_t));
+      }
+      uint32_t battery_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      battery_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      battery_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      battery_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->battery_length);
+      if(battery_lengthT > battery_length)
+        this->battery = (uint16_t*)realloc(this->battery, battery_lengthT * sizeof(uint16_t));
+      battery_length = battery_lengthT;
+      for( uint32_t i = 0; i < battery_length; i++){
+      this->st_battery =  ((uint16_t) (*(inbuffer + offset)));
+      this->st_battery |= ((uint16_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      offset += sizeof(this->st_battery);
+        memcpy( &(this->battery[i]), &(this->st_battery), sizeof(uint16_t));
+      }
+     return offset;
+    }
+
+    virtual const char * getType() override { return "leo_msgs/BlackBoxChunk"; };
+    virtual const char * getMD5() override { return "0fd346ee358f8a67de7bef1a18d081a3"; };
+
+  };
+
+}
+#endif
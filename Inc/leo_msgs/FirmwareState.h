@@ -0,0 +1,530 @@
+#ifndef _ROS_leo_msgs_FirmwareState_h
+#define _ROS_leo_msgs_FirmwareState_h
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "ros/msg.h"
+#include "ros/time.h"
+
+namespace leo_msgs
+{
+
+  class FirmwareState : public ros::Msg
+  {
+    public:
+      typedef ros::Time _stamp_type;
+      _stamp_type stamp;
+      typedef float _battery_type;
+      _battery_type battery;
+      typedef float _battery_averaged_type;
+      _battery_averaged_type battery_averaged;
+      typedef float _velocity_lin_x_type;
+      _velocity_lin_x_type velocity_lin_x;
+      typedef float _velocity_lin_y_type;
+      _velocity_lin_y_type velocity_lin_y;
+      typedef float _velocity_ang_type;
+      _velocity_ang_type velocity_ang;
+      typedef float _pose_x_type;
+      _pose_x_type pose_x;
+      typedef float _pose_y_type;
+      _pose_y_type pose_y;
+      typedef float _pose_yaw_type;
+      _pose_yaw_type pose_yaw;
+      float wheel_position[4];
+      float wheel_velocity[4];
+      float wheel_torque[4];
+      float wheel_pwm_duty_cycle[4];
+      typedef float _imu_temperature_type;
+      _imu_temperature_type imu_temperature;
+      typedef float _imu_gyro_x_type;
+      _imu_gyro_x_type imu_gyro_x;
+      typedef float _imu_gyro_y_type;
+      _imu_gyro_y_type imu_gyro_y;
+      typedef float _imu_gyro_z_type;
+      _imu_gyro_z_type imu_gyro_z;
+      typedef float _imu_accel_x_type;
+      _imu_accel_x_type imu_accel_x;
+      typedef float _imu_accel_y_type;
+      _imu_accel_y_type imu_accel_y;
+      typedef float _imu_accel_z_type;
+      _imu_accel_z_type imu_accel_z;
+
+    FirmwareState():
+      stamp(),
+      battery(0),
+      battery_averaged(0),
+      velocity_lin_x(0),
+      velocity_lin_y(0),
+      velocity_ang(0),
+      pose_x(0),
+      pose_y(0),
+      pose_yaw(0),
+      wheel_position(),
+      wheel_velocity(),
+      wheel_torque(),
+      wheel_pwm_duty_cycle(),
+      imu_temperature(0),
+      imu_gyro_x(0),
+      imu_gyro_y(0),
+      imu_gyro_z(0),
+      imu_accel_x(0),
+      imu_accel_y(0),
+      imu_accel_z(0)
+    {
+    }
+
+    virtual int serialize(unsigned char *outbuffer) const override
+    {
+      int offset = 0;
+      *(outbuffer + offset + 0) = (this->stamp.sec >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->stamp.sec >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->stamp.sec >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->stamp.sec >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->stamp.sec);
+      *(outbuffer + offset + 0) = (this->stamp.nsec >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->stamp.nsec >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->stamp.nsec >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->stamp.nsec >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->stamp.nsec);
+      union {
+        float real;
+        uint32_t base;
+      } u_battery;
+      u_battery.real = this->battery;
+      *(outbuffer + offset + 0) = (u_battery.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_battery.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_battery.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_battery.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->battery);
+      union {
+        float real;
+        uint32_t base;
+      } u_battery_averaged;
+      u_battery_averaged.real = this->battery_averaged;
+      *(outbuffer + offset + 0) = (u_battery_averaged.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_battery_averaged.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_battery_averaged.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_battery_averaged.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->battery_averaged);
+      union {
+        float real;
+        uint32_t base;
+      } u_velocity_lin_x;
+      u_velocity_lin_x.real = this->velocity_lin_x;
+      *(outbuffer + offset + 0) = (u_velocity_lin_x.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_velocity_lin_x.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_velocity_lin_x.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_velocity_lin_x.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->velocity_lin_x);
+      union {
+        float real;
+        uint32_t base;
+      } u_velocity_lin_y;
+      u_velocity_lin_y.real = this->velocity_lin_y;
+      *(outbuffer + offset + 0) = (u_velocity_lin_y.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_velocity_lin_y.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_velocity_lin_y.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_velocity_lin_y.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->velocity_lin_y);
+      union {
+        float real;
+        uint32_t base;
+      } u_velocity_ang;
+      u_velocity_ang.real = this->velocity_ang;
+      *(outbuffer + offset + 0) = (u_velocity_ang.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_velocity_ang.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_velocity_ang.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_velocity_ang.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->velocity_ang);
+      union {
+        float real;
+        uint32_t base;
+      } u_pose_x;
+      u_pose_x.real = this->pose_x;
+      *(outbuffer + offset + 0) = (u_pose_x.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_pose_x.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_pose_x.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_pose_x.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->pose_x);
+      union {
+        float real;
+        uint32_t base;
+      } u_pose_y;
+      u_pose_y.real = this->pose_y;
+      *(outbuffer + offset + 0) = (u_pose_y.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_pose_y.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_pose_y.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_pose_y.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->pose_y);
+      union {
+        float real;
+        uint32_t base;
+      } u_pose_yaw;
+      u_pose_yaw.real = this->pose_yaw;
+      *(outbuffer + offset + 0) = (u_pose_yaw.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_pose_yaw.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_pose_yaw.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_pose_yaw.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->pose_yaw);
+      for( uint32_t i = 0; i < 4; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_positioni;
+      u_wheel_positioni.real = this->wheel_position[i];
+      *(outbuffer + offset + 0) = (u_wheel_positioni.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_wheel_positioni.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_wheel_positioni.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_wheel_positioni.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->wheel_position[i]);
+      }
+      for( uint32_t i = 0; i < 4; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_velocityi;
+      u_wheel_velocityi.real = this->wheel_velocity[i];
+      *(outbuffer + offset + 0) = (u_wheel_velocityi.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_wheel_velocityi.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_wheel_velocityi.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_wheel_velocityi.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->wheel_velocity[i]);
+      }
+      for( uint32_t i = 0; i < 4; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_torquei;
+      u_wheel_torquei.real = this->wheel_torque[i];
+      *(outbuffer + offset + 0) = (u_wheel_torquei.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_wheel_torquei.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_wheel_torquei.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_wheel_torquei.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->wheel_torque[i]);
+      }
+      for( uint32_t i = 0; i < 4; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_pwm_duty_cyclei;
+      u_wheel_pwm_duty_cyclei.real = this->wheel_pwm_duty_cycle[i];
+      *(outbuffer + offset + 0) = (u_wheel_pwm_duty_cyclei.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_wheel_pwm_duty_cyclei.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_wheel_pwm_duty_cyclei.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_wheel_pwm_duty_cyclei.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->wheel_pwm_duty_cycle[i]);
+      }
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_temperature;
+      u_imu_temperature.real = this->imu_temperature;
+      *(outbuffer + offset + 0) = (u_imu_temperature.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_imu_temperature.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_imu_temperature.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_imu_temperature.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->imu_temperature);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_gyro_x;
+      u_imu_gyro_x.real = this->imu_gyro_x;
+      *(outbuffer + offset + 0) = (u_imu_gyro_x.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_imu_gyro_x.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_imu_gyro_x.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_imu_gyro_x.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->imu_gyro_x);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_gyro_y;
+      u_imu_gyro_y.real = this->imu_gyro_y;
+      *(outbuffer + offset + 0) = (u_imu_gyro_y.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_imu_gyro_y.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_imu_gyro_y.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_imu_gyro_y.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->imu_gyro_y);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_gyro_z;
+      u_imu_gyro_z.real = this->imu_gyro_z;
+      *(outbuffer + offset + 0) = (u_imu_gyro_z.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_imu_gyro_z.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_imu_gyro_z.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_imu_gyro_z.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->imu_gyro_z);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_accel_x;
+      u_imu_accel_x.real = this->imu_accel_x;
+      *(outbuffer + offset + 0) = (u_imu_accel_x.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_imu_accel_x.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_imu_accel_x.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_imu_accel_x.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->imu_accel_x);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_accel_y;
+      u_imu_accel_y.real = this->imu_accel_y;
+      *(outbuffer + offset + 0) = (u_imu_accel_y.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_imu_accel_y.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_imu_accel_y.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_imu_accel_y.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->imu_accel_y);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_accel_z;
+      u_imu_accel_z.real = this->imu_accel_z;
+      *(outbuffer + offset + 0) = (u_imu_accel_z.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_imu_accel_z.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_imu_accel_z.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_imu_accel_z.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->imu_accel_z);
+      return offset;
+    }
+
+    virtual int deserialize(unsigned char *inbuffer) override
+    {
+      int offset = 0;
+      this->stamp.sec =  ((uint32_t) (*(inbuffer + offset)));
+      this->stamp.sec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->stamp.sec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      this->stamp.sec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->stamp.sec);
+      this->stamp.nsec =  ((uint32_t) (*(inbuffer + offset)));
+      this->stamp.nsec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->stamp.nsec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      this->stamp.nsec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->stamp.nsec);
+      union {
+        float real;
+        uint32_t base;
+      } u_battery;
+      u_battery.base = 0;
+      u_battery.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_battery.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_battery.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_battery.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->battery = u_battery.real;
+      offset += sizeof(this->battery);
+      union {
+        float real;
+        uint32_t base;
+      } u_battery_averaged;
+      u_battery_averaged.base = 0;
+      u_battery_averaged.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_battery_averaged.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_battery_averaged.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_battery_averaged.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->battery_averaged = u_battery_averaged.real;
+      offset += sizeof(this->battery_averaged);
+      union {
+        float real;
+        uint32_t base;
+      } u_velocity_lin_x;
+      u_velocity_lin_x.base = 0;
+      u_velocity_lin_x.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_velocity_lin_x.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_velocity_lin_x.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_velocity_lin_x.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->velocity_lin_x = u_velocity_lin_x.real;
+      offset += sizeof(this->velocity_lin_x);
+      union {
+        float real;
+        uint32_t base;
+      } u_velocity_lin_y;
+      u_velocity_lin_y.base = 0;
+      u_velocity_lin_y.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_velocity_lin_y.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_velocity_lin_y.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_velocity_lin_y.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->velocity_lin_y = u_velocity_lin_y.real;
+      offset += sizeof(this->velocity_lin_y);
+      union {
+        float real;
+        uint32_t base;
+      } u_velocity_ang;
+      u_velocity_ang.base = 0;
+      u_velocity_ang.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_velocity_ang.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_velocity_ang.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_velocity_ang.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->velocity_ang = u_velocity_ang.real;
+      offset += sizeof(this->velocity_ang);
+      union {
+        float real;
+        uint32_t base;
+      } u_pose_x;
+      u_pose_x.base = 0;
+      u_pose_x.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_pose_x.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_pose_x.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_pose_x.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->pose_x = u_pose_x.real;
+      offset += sizeof(this->pose_x);
+      union {
+        float real;
+        uint32_t base;
+      } u_pose_y;
+      u_pose_y.base = 0;
+      u_pose_y.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_pose_y.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_pose_y.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_pose_y.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->pose_y = u_pose_y.real;
+      offset += sizeof(this->pose_y);
+      union {
+        float real;
+        uint32_t base;
+      } u_pose_yaw;
+      u_pose_yaw.base = 0;
+      u_pose_yaw.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_pose_yaw.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_pose_yaw.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_pose_yaw.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->pose_yaw = u_pose_yaw.real;
+      offset += sizeof(this->pose_yaw);
+      for( uint32_t i = 0; i < 4; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_positioni;
+      u_wheel_positioni.base = 0;
+      u_wheel_positioni.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_wheel_positioni.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_wheel_positioni.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_wheel_positioni.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->wheel_position[i] = u_wheel_positioni.real;
+      offset += sizeof(this->wheel_position[i]);
+      }
+      for( uint32_t i = 0; i < 4; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_velocityi;
+      u_wheel_velocityi.base = 0;
+      u_wheel_velocityi.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_wheel_velocityi.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_wheel_velocityi.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_wheel_velocityi.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->wheel_velocity[i] = u_wheel_velocityi.real;
+      offset += sizeof(this->wheel_velocity[i]);
+      }
+      for( uint32_t i = 0; i < 4; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_torquei;
+      u_wheel_torquei.base = 0;
+      u_wheel_torquei.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_wheel_torquei.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_wheel_torquei.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_wheel_torquei.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->wheel_torque[i] = u_wheel_torquei.real;
+      offset += sizeof(this->wheel_torque[i]);
+      }
+      for( uint32_t i = 0; i < 4; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_pwm_duty_cyclei;
+      u_wheel_pwm_duty_cyclei.base = 0;
+      u_wheel_pwm_duty_cyclei.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_wheel_pwm_duty_cyclei.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_wheel_pwm_duty_cyclei.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_wheel_pwm_duty_cyclei.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->wheel_pwm_duty_cycle[i] = u_wheel_pwm_duty_cyclei.real;
+      offset += sizeof(this->wheel_pwm_duty_cycle[i]);
+      }
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_temperature;
+      u_imu_temperature.base = 0;
+      u_imu_temperature.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_imu_temperature.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_imu_temperature.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_imu_temperature.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->imu_temperature = u_imu_temperature.real;
+      offset += sizeof(this->imu_temperature);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_gyro_x;
+      u_imu_gyro_x.base = 0;
+      u_imu_gyro_x.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_imu_gyro_x.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_imu_gyro_x.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_imu_gyro_x.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->imu_gyro_x = u_imu_gyro_x.real;
+      offset += sizeof(this->imu_gyro_x);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_gyro_y;
+      u_imu_gyro_y.base = 0;
+      u_imu_gyro_y.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_imu_gyro_y.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_imu_gyro_y.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_imu_gyro_y.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->imu_gyro_y = u_imu_gyro_y.real;
+      offset += sizeof(this->imu_gyro_y);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_gyro_z;
+      u_imu_gyro_z.base = 0;
+      u_imu_gyro_z.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_imu_gyro_z.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_imu_gyro_z.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_imu_gyro_z.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->imu_gyro_z = u_imu_gyro_z.real;
+      offset += sizeof(this->imu_gyro_z);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_accel_x;
+      u_imu_accel_x.base = 0;
+      u_imu_accel_x.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_imu_accel_x.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_imu_accel_x.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_imu_accel_x.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->imu_accel_x = u_imu_accel_x.real;
+      offset += sizeof(this->imu_accel_x);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_accel_y;
+      u_imu_accel_y.base = 0;
+      u_imu_accel_y.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_imu_accel_y.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_imu_accel_y.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_imu_accel_y.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->imu_accel_y = u_imu_accel_y.real;
+      offset += sizeof(this->imu_accel_y);
+      union {
+        float real;
+        uint32_t base;
+      } u_imu_accel_z;
+      u_imu_accel_z.base = 0;
+      u_imu_accel_z.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_imu_accel_z.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_imu_accel_z.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_imu_accel_z.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->imu_accel_z = u_imu_accel_z.real;
+      offset += sizeof(this->imu_accel_z);
+     return offset;
+    }
+
+    virtual const char * getType() override { return "leo_msgs/FirmwareState"; };
+    virtual const char * getMD5() override { return "1bdb92e1e88672ca76dcf6538572a0bc"; };
+
+  };
+
+}
+#endif
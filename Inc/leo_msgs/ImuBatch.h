@@ -0,0 +1,406 @@
+#ifndef _ROS_leo_msgs_ImuBatch_h
+#define _ROS_leo_msgs_ImuBatch_h
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "ros/msg.h"
+#include "ros/time.h"
+
+namespace leo_msgs
+{
+
+  class ImuBatch : public ros::Msg
+  {
+    public:
+      uint32_t stamp_length;
+      typedef ros::Time _stamp_type;
+      _stamp_type st_stamp;
+      _stamp_type * stamp;
+      uint32_t temperature_length;
+      typedef float _temperature_type;
+      _temperature_type st_temperature;
+      _temperature_type * temperature;
+      uint32_t gyro_x_length;
+      typedef float _gyro_x_type;
+      _gyro_x_type st_gyro_x;
+      _gyro_x_type * gyro_x;
+      uint32_t gyro_y_length;
+      typedef float _gyro_y_type;
+      _gyro_y_type st_gyro_y;
+      _gyro_y_type * gyro_y;
+      uint32_t gyro_z_length;
+      typedef float _gyro_z_type;
+      _gyro_z_type st_gyro_z;
+      _gyro_z_type * gyro_z;
+      uint32_t accel_x_length;
+      typedef float _accel_x_type;
+      _accel_x_type st_accel_x;
+      _accel_x_type * accel_x;
+      uint32_t accel_y_length;
+      typedef float _accel_y_type;
+      _accel_y_type st_accel_y;
+      _accel_y_type * accel_y;
+      uint32_t accel_z_length;
+      typedef float _accel_z_type;
+      _accel_z_type st_accel_z;
+      _accel_z_type * accel_z;
+
+    ImuBatch():
+      stamp_length(0),
+      st_stamp(),
+      stamp(nullptr),
+      temperature_length(0),
+      st_temperature(),
+      temperature(nullptr),
+      gyro_x_length(0),
+      st_gyro_x(),
+      gyro_x(nullptr),
+      gyro_y_length(0),
+      st_gyro_y(),
+      gyro_y(nullptr),
+      gyro_z_length(0),
+      st_gyro_z(),
+      gyro_z(nullptr),
+      accel_x_length(0),
+      st_accel_x(),
+      accel_x(nullptr),
+      accel_y_length(0),
+      st_accel_y(),
+      accel_y(nullptr),
+      accel_z_length(0),
+      st_accel_z(),
+      accel_z(nullptr)
+    {
+    }
+
+    virtual int serialize(unsigned char *outbuffer) const override
+    {
+      int offset = 0;
+      *(outbuffer + offset + 0) = (this->stamp_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->stamp_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->stamp_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->stamp_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->stamp_length);
+      for( uint32_t i = 0; i < stamp_length; i++){
+      *(outbuffer + offset + 0) = (this->stamp[i].sec >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->stamp[i].sec >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->stamp[i].sec >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->stamp[i].sec >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->stamp[i].sec);
+      *(outbuffer + offset + 0) = (this->stamp[i].nsec >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->stamp[i].nsec >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->stamp[i].nsec >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->stamp[i].nsec >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->stamp[i].nsec);
+      }
+      *(outbuffer + offset + 0) = (this->temperature_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->temperature_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->temperature_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->temperature_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->temperature_length);
+      for( uint32_t i = 0; i < temperature_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_temperaturei;
+      u_temperaturei.real = this->temperature[i];
+      *(outbuffer + offset + 0) = (u_temperaturei.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_temperaturei.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_temperaturei.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_temperaturei.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->temperature[i]);
+      }
+      *(outbuffer + offset + 0) = (this->gyro_x_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->gyro_x_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->gyro_x_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->gyro_x_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->gyro_x_length);
+      for( uint32_t i = 0; i < gyro_x_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_gyro_xi;
+      u_gyro_xi.real = this->gyro_x[i];
+      *(outbuffer + offset + 0) = (u_gyro_xi.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_gyro_xi.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_gyro_xi.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_gyro_xi.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->gyro_x[i]);
+      }
+      *(outbuffer + offset + 0) = (this->gyro_y_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->gyro_y_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->gyro_y_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->gyro_y_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->gyro_y_length);
+      for( uint32_t i = 0; i < gyro_y_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_gyro_yi;
+      u_gyro_yi.real = this->gyro_y[i];
+      *(outbuffer + offset + 0) = (u_gyro_yi.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_gyro_yi.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_gyro_yi.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_gyro_yi.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->gyro_y[i]);
+      }
+      *(outbuffer + offset + 0) = (this->gyro_z_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->gyro_z_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->gyro_z_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->gyro_z_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->gyro_z_length);
+      for( uint32_t i = 0; i < gyro_z_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_gyro_zi;
+      u_gyro_zi.real = this->gyro_z[i];
+      *(outbuffer + offset + 0) = (u_gyro_zi.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_gyro_zi.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_gyro_zi.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_gyro_zi.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->gyro_z[i]);
+      }
+      *(outbuffer + offset + 0) = (this->accel_x_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->accel_x_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->accel_x_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->accel_x_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->accel_x_length);
+      for( uint32_t i = 0; i < accel_x_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_accel_xi;
+      u_accel_xi.real = this->accel_x[i];
+      *(outbuffer + offset + 0) = (u_accel_xi.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_accel_xi.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_accel_xi.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_accel_xi.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->accel_x[i]);
+      }
+      *(outbuffer + offset + 0) = (this->accel_y_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->accel_y_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->accel_y_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->accel_y_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->accel_y_length);
+      for( uint32_t i = 0; i < accel_y_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_accel_yi;
+      u_accel_yi.real = this->accel_y[i];
+      *(outbuffer + offset + 0) = (u_accel_yi.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_accel_yi.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_accel_yi.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_accel_yi.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->accel_y[i]);
+      }
+      *(outbuffer + offset + 0) = (this->accel_z_length >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->accel_z_length >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->accel_z_length >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->accel_z_length >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->accel_z_length);
+      for( uint32_t i = 0; i < accel_z_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_accel_zi;
+      u_accel_zi.real = this->accel_z[i];
+      *(outbuffer + offset + 0) = (u_accel_zi.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_accel_zi.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_accel_zi.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_accel_zi.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->accel_z[i]);
+      }
+      return offset;
+    }
+
+    virtual int deserialize(unsigned char *inbuffer) override
+    {
+      int offset = 0;
+      uint32_t stamp_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      stamp_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      stamp_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      stamp_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->stamp_length);
+      if(stamp_lengthT > stamp_length)
+        this->stamp = (ros::Time*)realloc(this->stamp, stamp_lengthT * sizeof(ros::Time));
+      stamp_length = stamp_lengthT;
+      for( uint32_t i = 0; i < stamp_length; i++){
+      this->st_stamp.sec =  ((uint32_t) (*(inbuffer + offset)));
+      this->st_stamp.sec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->st_stamp.sec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      this->st_stamp.sec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->st_stamp.sec);
+      this->st_stamp.nsec =  ((uint32_t) (*(inbuffer + offset)));
+      this->st_stamp.nsec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->st_stamp.nsec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      this->st_stamp.nsec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->st_stamp.nsec);
+        memcpy( &(this->stamp[i]), &(this->st_stamp), sizeof(ros::Time));
+      }
+      uint32_t temperature_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      temperature_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      temperature_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      temperature_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->temperature_length);
+      if(temperature_lengthT > temperature_length)
+        this->temperature = (float*)realloc(this->temperature, temperature_lengthT * sizeof(float));
+      temperature_length = temperature_lengthT;
+      for( uint32_t i = 0; i < temperature_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_st_temperature;
+      u_st_temperature.base = 0;
+      u_st_temperature.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_temperature.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_st_temperature.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_st_temperature.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->st_temperature = u_st_temperature.real;
+      offset += sizeof(this->st_temperature);
+        memcpy( &(this->temperature[i]), &(this->st_temperature), sizeof(float));
+      }
+      uint32_t gyro_x_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      gyro_x_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      gyro_x_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      gyro_x_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->gyro_x_length);
+      if(gyro_x_lengthT > gyro_x_length)
+        this->gyro_x = (float*)realloc(this->gyro_x, gyro_x_lengthT * sizeof(float));
+      gyro_x_length = gyro_x_lengthT;
+      for( uint32_t i = 0; i < gyro_x_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_st_gyro_x;
+      u_st_gyro_x.base = 0;
+      u_st_gyro_x.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_gyro_x.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_st_gyro_x.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_st_gyro_x.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->st_gyro_x = u_st_gyro_x.real;
+      offset += sizeof(this->st_gyro_x);
+        memcpy( &(this->gyro_x[i]), &(this->st_gyro_x), sizeof(float));
+      }
+      uint32_t gyro_y_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      gyro_y_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      gyro_y_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      gyro_y_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->gyro_y_length);
+      if(gyro_y_lengthT > gyro_y_length)
+        this->gyro_y = (float*)realloc(this->gyro_y, gyro_y_lengthT * sizeof(float));
+      gyro_y_length = gyro_y_lengthT;
+      for( uint32_t i = 0; i < gyro_y_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_st_gyro_y;
+      u_st_gyro_y.base = 0;
+      u_st_gyro_y.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_gyro_y.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_st_gyro_y.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_st_gyro_y.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->st_gyro_y = u_st_gyro_y.real;
+      offset += sizeof(this->st_gyro_y);
+        memcpy( &(this->gyro_y[i]), &(this->st_gyro_y), sizeof(float));
+      }
+      uint32_t gyro_z_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      gyro_z_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      gyro_z_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      gyro_z_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->gyro_z_length);
+      if(gyro_z_lengthT > gyro_z_length)
+        this->gyro_z = (float*)realloc(this->gyro_z, gyro_z_lengthT * sizeof(float));
+      gyro_z_length = gyro_z_lengthT;
+      for( uint32_t i = 0; i < gyro_z_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_st_gyro_z;
+      u_st_gyro_z.base = 0;
+      u_st_gyro_z.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_gyro_z.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_st_gyro_z.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_st_gyro_z.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->st_gyro_z = u_st_gyro_z.real;
+      offset += sizeof(this->st_gyro_z);
+        memcpy( &(this->gyro_z[i]), &(this->st_gyro_z), sizeof(float));
+      }
+      uint32_t accel_x_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      accel_x_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      accel_x_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      accel_x_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->accel_x_length);
+      if(accel_x_lengthT > accel_x_length)
+        this->accel_x = (float*)realloc(this->accel_x, accel_x_lengthT * sizeof(float));
+      accel_x_length = accel_x_lengthT;
+      for( uint32_t i = 0; i < accel_x_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_st_accel_x;
+      u_st_accel_x.base = 0;
+      u_st_accel_x.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_accel_x.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_st_accel_x.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_st_accel_x.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->st_accel_x = u_st_accel_x.real;
+      offset += sizeof(this->st_accel_x);
+        memcpy( &(this->accel_x[i]), &(this->st_accel_x), sizeof(float));
+      }
+      uint32_t accel_y_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      accel_y_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      accel_y_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      accel_y_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->accel_y_length);
+      if(accel_y_lengthT > accel_y_length)
+        this->accel_y = (float*)realloc(this->accel_y, accel_y_lengthT * sizeof(float));
+      accel_y_length = accel_y_lengthT;
+      for( uint32_t i = 0; i < accel_y_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_st_accel_y;
+      u_st_accel_y.base = 0;
+      u_st_accel_y.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_accel_y.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_st_accel_y.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_st_accel_y.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->st_accel_y = u_st_accel_y.real;
+      offset += sizeof(this->st_accel_y);
+        memcpy( &(this->accel_y[i]), &(this->st_accel_y), sizeof(float));
+      }
+      uint32_t accel_z_lengthT = ((uint32_t) (*(inbuffer + offset)));
+      accel_z_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      accel_z_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      accel_z_lengthT |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->accel_z_length);
+      if(accel_z_lengthT > accel_z_length)
+        this->accel_z = (float*)realloc(this->accel_z, accel_z_lengthT * sizeof(float));
+      accel_z_length = accel_z_lengthT;
+      for( uint32_t i = 0; i < accel_z_length; i++){
+      union {
+        float real;
+        uint32_t base;
+      } u_st_accel_z;
+      u_st_accel_z.base = 0;
+      u_st_accel_z.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_st_accel_z.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_st_accel_z.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_st_accel_z.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->st_accel_z = u_st_accel_z.real;
+      offset += sizeof(this->st_accel_z);
+        memcpy( &(this->accel_z[i]), &(this->st_accel_z), sizeof(float));
+      }
+     return offset;
+    }
+
+    virtual const char * getType() override { return "leo_msgs/ImuBatch"; };
+    virtual const char * getMD5() override { return "52af4d819c32fcdae744e8955771e3a0"; };
+
+  };
+
+}
+#endif
@@ -0,0 +1,527 @@
+#ifndef _ROS_leo_msgs_SetParams_h
+#define _ROS_leo_msgs_SetParams_h
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "ros/msg.h"
+
+namespace leo_msgs
+{
+
+static const char SETPARAMS[] = "leo_msgs/SetParams";
+
+  class SetParamsRequest : public ros::Msg
+  {
+    public:
+      typedef bool _mecanum_wheels_type;
+      _mecanum_wheels_type mecanum_wheels;
+      typedef float _wheel_radius_type;
+      _wheel_radius_type wheel_radius;
+      typedef float _wheel_separation_type;
+      _wheel_separation_type wheel_separation;
+      typedef float _wheel_base_type;
+      _wheel_base_type wheel_base;
+      typedef float _angular_velocity_multiplier_type;
+      _angular_velocity_multiplier_type angular_velocity_multiplier;
+      typedef int32_t _input_timeout_type;
+      _input_timeout_type input_timeout;
+      typedef float _encoder_resolution_type;
+      _encoder_resolution_type encoder_resolution;
+      typedef float _torque_constant_type;
+      _torque_constant_type torque_constant;
+      typedef float _pid_p_type;
+      _pid_p_type pid_p;
+      typedef float _pid_i_type;
+      _pid_i_type pid_i;
+      typedef float _pid_d_type;
+      _pid_d_type pid_d;
+      typedef float _pwm_duty_limit_type;
+      _pwm_duty_limit_type pwm_duty_limit;
+      typedef float _battery_min_voltage_type;
+      _battery_min_voltage_type battery_min_voltage;
+      typedef int32_t _control_frequency_type;
+      _control_frequency_type control_frequency;
+      typedef int32_t _imu_batch_decimation_type;
+      _imu_batch_decimation_type imu_batch_decimation;
+      typedef int32_t _state_frame_type;
+      _state_frame_type state_frame;
+      typedef bool _odom_fusion_type;
+      _odom_fusion_type odom_fusion;
+      typedef float _current_limit_type;
+      _current_limit_type current_limit;
+
+    SetParamsRequest():
+      mecanum_wheels(0),
+      wheel_radius(0),
+      wheel_separation(0),
+      wheel_base(0),
+      angular_velocity_multiplier(0),
+      input_timeout(0),
+      encoder_resolution(0),
+      torque_constant(0),
+      pid_p(0),
+      pid_i(0),
+      pid_d(0),
+      pwm_duty_limit(0),
+      battery_min_voltage(0),
+      control_frequency(0),
+      imu_batch_decimation(0),
+      state_frame(0),
+      odom_fusion(0),
+      current_limit(0)
+    {
+    }
+
+    virtual int serialize(unsigned char *outbuffer) const override
+    {
+      int offset = 0;
+      union {
+        bool real;
+        uint8_t base;
+      } u_mecanum_wheels;
+      u_mecanum_wheels.real = this->mecanum_wheels;
+      *(outbuffer + offset + 0) = (u_mecanum_wheels.base >> (8 * 0)) & 0xFF;
+      offset += sizeof(this->mecanum_wheels);
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_radius;
+      u_wheel_radius.real = this->wheel_radius;
+      *(outbuffer + offset + 0) = (u_wheel_radius.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_wheel_radius.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_wheel_radius.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_wheel_radius.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->wheel_radius);
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_separation;
+      u_wheel_separation.real = this->wheel_separation;
+      *(outbuffer + offset + 0) = (u_wheel_separation.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_wheel_separation.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_wheel_separation.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_wheel_separation.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->wheel_separation);
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_base;
+      u_wheel_base.real = this->wheel_base;
+      *(outbuffer + offset + 0) = (u_wheel_base.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_wheel_base.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_wheel_base.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_wheel_base.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->wheel_base);
+      union {
+        float real;
+        uint32_t base;
+      } u_angular_velocity_multiplier;
+      u_angular_velocity_multiplier.real = this->angular_velocity_multiplier;
+      *(outbuffer + offset + 0) = (u_angular_velocity_multiplier.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_angular_velocity_multiplier.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_angular_velocity_multiplier.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_angular_velocity_multiplier.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->angular_velocity_multiplier);
+      union {
+        int32_t real;
+        uint32_t base;
+      } u_input_timeout;
+      u_input_timeout.real = this->input_timeout;
+      *(outbuffer + offset + 0) = (u_input_timeout.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_input_timeout.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_input_timeout.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_input_timeout.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->input_timeout);
+      union {
+        float real;
+        uint32_t base;
+      } u_encoder_resolution;
+      u_encoder_resolution.real = this->encoder_resolution;
+      *(outbuffer + offset + 0) = (u_encoder_resolution.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_encoder_resolution.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_encoder_resolution.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_encoder_resolution.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->encoder_resolution);
+      union {
+        float real;
+        uint32_t base;
+      } u_torque_constant;
+      u_torque_constant.real = this->torque_constant;
+      *(outbuffer + offset + 0) = (u_torque_constant.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_torque_constant.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_torque_constant.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_torque_constant.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->torque_constant);
+      union {
+        float real;
+        uint32_t base;
+      } u_pid_p;
+      u_pid_p.real = this->pid_p;
+      *(outbuffer + offset + 0) = (u_pid_p.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_pid_p.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_pid_p.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_pid_p.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->pid_p);
+      union {
+        float real;
+        uint32_t base;
+      } u_pid_i;
+      u_pid_i.real = this->pid_i;
+      *(outbuffer + offset + 0) = (u_pid_i.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_pid_i.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_pid_i.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_pid_i.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->pid_i);
+      union {
+        float real;
+        uint32_t base;
+      } u_pid_d;
+      u_pid_d.real = this->pid_d;
+      *(outbuffer + offset + 0) = (u_pid_d.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_pid_d.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_pid_d.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_pid_d.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->pid_d);
+      union {
+        float real;
+        uint32_t base;
+      } u_pwm_duty_limit;
+      u_pwm_duty_limit.real = this->pwm_duty_limit;
+      *(outbuffer + offset + 0) = (u_pwm_duty_limit.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_pwm_duty_limit.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_pwm_duty_limit.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_pwm_duty_limit.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->pwm_duty_limit);
+      union {
+        float real;
+        uint32_t base;
+      } u_battery_min_voltage;
+      u_battery_min_voltage.real = this->battery_min_voltage;
+      *(outbuffer + offset + 0) = (u_battery_min_voltage.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_battery_min_voltage.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_battery_min_voltage.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_battery_min_voltage.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->battery_min_voltage);
+      union {
+        int32_t real;
+        uint32_t base;
+      } u_control_frequency;
+      u_control_frequency.real = this->control_frequency;
+      *(outbuffer + offset + 0) = (u_control_frequency.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_control_frequency.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_control_frequency.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_control_frequency.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->control_frequency);
+      union {
+        int32_t real;
+        uint32_t base;
+      } u_imu_batch_decimation;
+      u_imu_batch_decimation.real = this->imu_batch_decimation;
+      *(outbuffer + offset + 0) = (u_imu_batch_decimation.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_imu_batch_decimation.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_imu_batch_decimation.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_imu_batch_decimation.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->imu_batch_decimation);
+      union {
+        int32_t real;
+        uint32_t base;
+      } u_state_frame;
+      u_state_frame.real = this->state_frame;
+      *(outbuffer + offset + 0) = (u_state_frame.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_state_frame.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_state_frame.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_state_frame.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->state_frame);
+      union {
+        bool real;
+        uint8_t base;
+      } u_odom_fusion;
+      u_odom_fusion.real = this->odom_fusion;
+      *(outbuffer + offset + 0) = (u_odom_fusion.base >> (8 * 0)) & 0xFF;
+      offset += sizeof(this->odom_fusion);
+      union {
+        float real;
+        uint32_t base;
+      } u_current_limit;
+      u_current_limit.real = this->current_limit;
+      *(outbuffer + offset + 0) = (u_current_limit.base >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (u_current_limit.base >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (u_current_limit.base >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (u_current_limit.base >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->current_limit);
+      return offset;
+    }
+
+    virtual int deserialize(unsigned char *inbuffer) override
+    {
+      int offset = 0;
+      union {
+        bool real;
+        uint8_t base;
+      } u_mecanum_wheels;
+      u_mecanum_wheels.base = 0;
+      u_mecanum_wheels.base |= ((uint8_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      this->mecanum_wheels = u_mecanum_wheels.real;
+      offset += sizeof(this->mecanum_wheels);
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_radius;
+      u_wheel_radius.base = 0;
+      u_wheel_radius.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_wheel_radius.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_wheel_radius.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_wheel_radius.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->wheel_radius = u_wheel_radius.real;
+      offset += sizeof(this->wheel_radius);
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_separation;
+      u_wheel_separation.base = 0;
+      u_wheel_separation.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_wheel_separation.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_wheel_separation.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_wheel_separation.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->wheel_separation = u_wheel_separation.real;
+      offset += sizeof(this->wheel_separation);
+      union {
+        float real;
+        uint32_t base;
+      } u_wheel_base;
+      u_wheel_base.base = 0;
+      u_wheel_base.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_wheel_base.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_wheel_base.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_wheel_base.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->wheel_base = u_wheel_base.real;
+      offset += sizeof(this->wheel_base);
+      union {
+        float real;
+        uint32_t base;
+      } u_angular_velocity_multiplier;
+      u_angular_velocity_multiplier.base = 0;
+      u_angular_velocity_multiplier.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_angular_velocity_multiplier.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_angular_velocity_multiplier.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_angular_velocity_multiplier.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->angular_velocity_multiplier = u_angular_velocity_multiplier.real;
+      offset += sizeof(this->angular_velocity_multiplier);
+      union {
+        int32_t real;
+        uint32_t base;
+      } u_input_timeout;
+      u_input_timeout.base = 0;
+      u_input_timeout.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_input_timeout.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_input_timeout.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_input_timeout.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->input_timeout = u_input_timeout.real;
+      offset += sizeof(this->input_timeout);
+      union {
+        float real;
+        uint32_t base;
+      } u_encoder_resolution;
+      u_encoder_resolution.base = 0;
+      u_encoder_resolution.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_encoder_resolution.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_encoder_resolution.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_encoder_resolution.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->encoder_resolution = u_encoder_resolution.real;
+      offset += sizeof(this->encoder_resolution);
+      union {
+        float real;
+        uint32_t base;
+      } u_torque_constant;
+      u_torque_constant.base = 0;
+      u_torque_constant.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_torque_constant.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_torque_constant.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_torque_constant.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->torque_constant = u_torque_constant.real;
+      offset += sizeof(this->torque_constant);
+      union {
+        float real;
+        uint32_t base;
+      } u_pid_p;
+      u_pid_p.base = 0;
+      u_pid_p.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_pid_p.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_pid_p.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_pid_p.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->pid_p = u_pid_p.real;
+      offset += sizeof(this->pid_p);
+      union {
+        float real;
+        uint32_t base;
+      } u_pid_i;
+      u_pid_i.base = 0;
+      u_pid_i.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_pid_i.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_pid_i.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_pid_i.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->pid_i = u_pid_i.real;
+      offset += sizeof(this->pid_i);
+      union {
+        float real;
+        uint32_t base;
+      } u_pid_d;
+      u_pid_d.base = 0;
+      u_pid_d.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_pid_d.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_pid_d.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_pid_d.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->pid_d = u_pid_d.real;
+      offset += sizeof(this->pid_d);
+      union {
+        float real;
+        uint32_t base;
+      } u_pwm_duty_limit;
+      u_pwm_duty_limit.base = 0;
+      u_pwm_duty_limit.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_pwm_duty_limit.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_pwm_duty_limit.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_pwm_duty_limit.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->pwm_duty_limit = u_pwm_duty_limit.real;
+      offset += sizeof(this->pwm_duty_limit);
+      union {
+        float real;
+        uint32_t base;
+      } u_battery_min_voltage;
+      u_battery_min_voltage.base = 0;
+      u_battery_min_voltage.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_battery_min_voltage.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_battery_min_voltage.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_battery_min_voltage.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->battery_min_voltage = u_battery_min_voltage.real;
+      offset += sizeof(this->battery_min_voltage);
+      union {
+        int32_t real;
+        uint32_t base;
+      } u_control_frequency;
+      u_control_frequency.base = 0;
+      u_control_frequency.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_control_frequency.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_control_frequency.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_control_frequency.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->control_frequency = u_control_frequency.real;
+      offset += sizeof(this->control_frequency);
+      union {
+        int32_t real;
+        uint32_t base;
+      } u_imu_batch_decimation;
+      u_imu_batch_decimation.base = 0;
+      u_imu_batch_decimation.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_imu_batch_decimation.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_imu_batch_decimation.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_imu_batch_decimation.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->imu_batch_decimation = u_imu_batch_decimation.real;
+      offset += sizeof(this->imu_batch_decimation);
+      union {
+        int32_t real;
+        uint32_t base;
+      } u_state_frame;
+      u_state_frame.base = 0;
+      u_state_frame.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_state_frame.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_state_frame.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_state_frame.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->state_frame = u_state_frame.real;
+      offset += sizeof(this->state_frame);
+      union {
+        bool real;
+        uint8_t base;
+      } u_odom_fusion;
+      u_odom_fusion.base = 0;
+      u_odom_fusion.base |= ((uint8_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      this->odom_fusion = u_odom_fusion.real;
+      offset += sizeof(this->odom_fusion);
+      union {
+        float real;
+        uint32_t base;
+      } u_current_limit;
+      u_current_limit.base = 0;
+      u_current_limit.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      u_current_limit.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      u_current_limit.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      u_current_limit.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      this->current_limit = u_current_limit.real;
+      offset += sizeof(this->current_limit);
+     return offset;
+    }
+
+    virtual const char * getType() override { return SETPARAMS; };
+    virtual const char * getMD5() override { return "1f90bdfdeccf32f36610b1319b52c686"; };
+
+  };
+
+  class SetParamsResponse : public ros::Msg
+  {
+    public:
+      typedef bool _success_type;
+      _success_type success;
+      typedef const char* _message_type;
+      _message_type message;
+
+    SetParamsResponse():
+      success(0),
+      message("")
+    {
+    }
+
+    virtual int serialize(unsigned char *outbuffer) const override
+    {
+      int offset = 0;
+      union {
+        bool real;
+        uint8_t base;
+      } u_success;
+      u_success.real = this->success;
+      *(outbuffer + offset + 0) = (u_success.base >> (8 * 0)) & 0xFF;
+      offset += sizeof(this->success);
+      uint32_t length_message = strlen(this->message);
+      varToArr(outbuffer + offset, length_message);
+      offset += 4;
+      memcpy(outbuffer + offset, this->message, length_message);
+      offset += length_message;
+      return offset;
+    }
+
+    virtual int deserialize(unsigned char *inbuffer) override
+    {
+      int offset = 0;
+      union {
+        bool real;
+        uint8_t base;
+      } u_success;
+      u_success.base = 0;
+      u_success.base |= ((uint8_t) (*(inbuffer + offset + 0))) << (8 * 0);
+      this->success = u_success.real;
+      offset += sizeof(this->success);
+      uint32_t length_message;
+      arrToVar(length_message, (inbuffer + offset));
+      offset += 4;
+      for(unsigned int k= offset; k< offset+length_message; ++k){
+          inbuffer[k-1]=inbuffer[k];
+      }
+      inbuffer[offset+length_message-1]=0;
+      this->message = (char *)(inbuffer + offset-1);
+      offset += length_message;
+     return offset;
+    }
+
+    virtual const char * getType() override { return SETPARAMS; };
+    virtual const char * getMD5() override { return "937c9679a518e3a18d831e57125ea522"; };
+
+  };
+
+  class SetParams {
+    public:
+    typedef SetParamsRequest Request;
+    typedef SetParamsResponse Response;
+  };
+
+
+}
+#endif
@@ -6,10 +6,26 @@ extern "C" {
 
 #include <stdint.h>
 
-extern volatile uint16_t adc_buff[5];
+#include "stm32f4xx_hal.h"
+
+// Number of channels in the ADC regular conversion sequence
+#define ADC_CHANNELS 5
+
+// Number of conversion sequences averaged into each adc_buff value
+#define ADC_OVERSAMPLING 21
+
+// The DMA buffer holds two halves so that one can be averaged while the other
+// is being filled
+#define ADC_DMA_BUFFER_SIZE (2 * ADC_OVERSAMPLING * ADC_CHANNELS)
+
+extern volatile uint16_t adc_buff[ADC_CHANNELS];
+extern volatile uint16_t adc_dma_buff[ADC_DMA_BUFFER_SIZE];
 void setup();
 void loop();
 void update();
+void sampleEncoders();
+void encoderOverflowCallback(TIM_TypeDef *tim);
+void rosserialIdleCallback();
 
 #ifdef __cplusplus
 }
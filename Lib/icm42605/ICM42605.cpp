@@ -91,6 +91,100 @@ void ICM42605::readData(int16_t* destination) {
   // Read the 14 raw data registers into data array
   readBytes(ICM42605_TEMP_DATA1, 14, &rawData[0]);
 
+  convertData(rawData, destination);
+}
+
+bool ICM42605::startReadData() {
+  return startRead(ICM42605_TEMP_DATA1, _rawData, 14);
+}
+
+bool ICM42605::getData(int16_t* destination) {
+  if (!_dataReady) return false;
+
+  convertData(_rawData, destination);
+  _dataReady = false;
+  return true;
+}
+
+void ICM42605::readCompleteCallback() {
+  _dataReady = true;
+  _transferBusy = false;
+}
+
+void ICM42605::readErrorCallback() {
+  _transferBusy = false;
+}
+
+void ICM42605::enableFifo() {
+  // store accel, gyro and temperature data (16-byte packets)
+  uint8_t temp = readByte(ICM42605_FIFO_CONFIG1);
+  writeByte(ICM42605_FIFO_CONFIG1, temp | 0x07);
+
+  // stream-to-FIFO mode
+  writeByte(ICM42605_FIFO_CONFIG, 0x40);
+
+  // flush the FIFO
+  writeByte(ICM42605_SIGNAL_PATH_RESET, 0x02);
+}
+
+void ICM42605::enableDataReadyInterrupt() {
+  // INT2 in pulsed mode, push-pull, active high
+  uint8_t temp = readByte(ICM42605_INT_CONFIG);
+  writeByte(ICM42605_INT_CONFIG, (temp & 0x07) | 0x18);
+
+  // the pulses need the asynchronous reset bit cleared
+  temp = readByte(ICM42605_INT_CONFIG1);
+  writeByte(ICM42605_INT_CONFIG1, temp & ~0x10);
+
+  // route UI data ready to INT2
+  temp = readByte(ICM42605_INT_SOURCE3);
+  writeByte(ICM42605_INT_SOURCE3, temp | 0x08);
+}
+
+bool ICM42605::startReadFifo(uint8_t* buffer, uint16_t packets) {
+  return startRead(ICM42605_FIFO_DATA, buffer,
+                   packets * ICM42605_FIFO_PACKET_SIZE);
+}
+
+bool ICM42605::fifoDataReady() {
+  if (!_dataReady) return false;
+
+  _dataReady = false;
+  return true;
+}
+
+bool ICM42605::readFifoPacket(const uint8_t* packet, int16_t* destination) {
+  // Header bit 7 is set when the FIFO was empty, bits 6 and 5 tell whether
+  // the packet contains accel and gyro data
+  if ((packet[0] & 0xE0) != 0x60) return false;
+
+  // Same layout as in readData(). The FIFO stores the temperature as a single
+  // byte with 64 times lower resolution than TEMP_DATA registers.
+  destination[0] = static_cast<int16_t>(static_cast<int8_t>(packet[13]) * 64);
+  destination[1] = ((int16_t)packet[1] << 8) | packet[2];
+  destination[2] = ((int16_t)packet[3] << 8) | packet[4];
+  destination[3] = ((int16_t)packet[5] << 8) | packet[6];
+  destination[4] = ((int16_t)packet[7] << 8) | packet[8];
+  destination[5] = ((int16_t)packet[9] << 8) | packet[10];
+  destination[6] = ((int16_t)packet[11] << 8) | packet[12];
+
+  // -32768 marks samples taken before the sensor has settled
+  return destination[1] != INT16_MIN && destination[4] != INT16_MIN;
+}
+
+bool ICM42605::startRead(uint16_t address, uint8_t* data, uint16_t size) {
+  if (_transferBusy) return false;
+
+  _transferBusy = true;
+  if (HAL_I2C_Mem_Read_IT(_i2c_bus, ICM42605_ADDRESS, address,
+                          I2C_MEMADD_SIZE_8BIT, data, size) != HAL_OK) {
+    _transferBusy = false;
+    return false;
+  }
+  return true;
+}
+
+void ICM42605::convertData(const uint8_t* rawData, int16_t* destination) {
   // Turn the MSB and LSB into a signed 16-bit value
   destination[0] = ((int16_t)rawData[0] << 8) | rawData[1];
   destination[1] = ((int16_t)rawData[2] << 8) | rawData[3];
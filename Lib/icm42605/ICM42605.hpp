@@ -136,6 +136,9 @@ https://store.invensense.com/datasheets/invensense/DS-ICM-42605v1-2.pdf
 
 #define ICM42605_ADDRESS (0x68 << 1)  // Address of ICM42605 accel/gyro
 
+// Size of a FIFO packet with accel, gyro, temperature and timestamp data
+#define ICM42605_FIFO_PACKET_SIZE 16
+
 #define AFS_2G 0x03
 #define AFS_4G 0x02
 #define AFS_8G 0x01
@@ -184,11 +187,37 @@ class ICM42605 {
   void init(uint8_t Ascale, uint8_t Gscale, uint8_t AODR, uint8_t GODR);
   void readData(int16_t* destination);
 
+  // Non-blocking counterpart of readData(). startReadData() only queues the
+  // interrupt-driven transfer, the result can be fetched with getData() once
+  // readCompleteCallback() has been called from HAL_I2C_MemRxCpltCallback.
+  bool startReadData();
+  bool getData(int16_t* destination);
+  void readCompleteCallback();
+  void readErrorCallback();
+
+  // FIFO mode. The sensor queues every accel/gyro sample in its FIFO, which
+  // can then be drained with a single burst read from FIFO_DATA. Reading more
+  // packets than there are stored is fine - the excess ones are marked invalid
+  // and rejected by readFifoPacket().
+  void enableFifo();
+  // Pulses the INT2 pin (push-pull, active high) on every new sample
+  void enableDataReadyInterrupt();
+  bool startReadFifo(uint8_t* buffer, uint16_t packets);
+  bool fifoDataReady();
+  static bool readFifoPacket(const uint8_t* packet, int16_t* destination);
+
  private:
   uint8_t readByte(uint16_t address);
   void writeByte(uint16_t address, uint8_t data);
   void readBytes(uint16_t address, uint16_t size, uint8_t* data);
 
+  bool startRead(uint16_t address, uint8_t* data, uint16_t size);
+  static void convertData(const uint8_t* rawData, int16_t* destination);
+
   float _aRes, _gRes;
   I2C_HandleTypeDef* _i2c_bus;
+
+  uint8_t _rawData[14];
+  volatile bool _transferBusy = false;
+  volatile bool _dataReady = false;
 };
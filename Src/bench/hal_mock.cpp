@@ -0,0 +1,140 @@
+#include "bench/hal_mock.hpp"
+
+#include <cstring>
+
+#include "adc.h"
+#include "i2c.h"
+#include "mainf.h"
+#include "tim.h"
+#include "usart.h"
+
+#include <ICM42605.hpp>
+
+GPIO_TypeDef mock_GPIOA, mock_GPIOB, mock_GPIOC;
+TIM_TypeDef mock_TIM1, mock_TIM2, mock_TIM3, mock_TIM4, mock_TIM5, mock_TIM9,
+    mock_TIM11;
+RCC_TypeDef mock_RCC;
+IWDG_TypeDef mock_IWDG;
+DWT_Type mock_DWT;
+CoreDebug_Type mock_CoreDebug;
+SysTick_Type mock_SysTick = {0, 83999, 83999, 0};
+SCB_Type mock_SCB;
+
+uint32_t SystemCoreClock = 84000000;
+
+TIM_HandleTypeDef htim11 = {TIM11};
+I2C_HandleTypeDef hi2c1;
+UART_HandleTypeDef huart1;
+ADC_HandleTypeDef hadc1;
+
+volatile uint16_t adc_buff[ADC_CHANNELS];
+volatile uint16_t adc_dma_buff[ADC_DMA_BUFFER_SIZE];
+
+static uint64_t time_us = 0;
+static uint32_t primask = 0;
+
+// Simulated sensor FIFO, holding packets in the ICM42605 format
+static constexpr uint16_t IMU_FIFO_PACKETS = 128;
+static uint8_t imu_fifo[IMU_FIFO_PACKETS][ICM42605_FIFO_PACKET_SIZE];
+static uint16_t imu_fifo_count = 0;
+static bool read_pending = false;
+
+namespace mock {
+
+void advanceTime(uint32_t us) {
+  time_us += us;
+  DWT->CYCCNT += us * (SystemCoreClock / 1000000);
+  // SysTick counts down from LOAD once every millisecond
+  const uint32_t load = SysTick->LOAD + 1;
+  SysTick->VAL = SysTick->LOAD - static_cast<uint32_t>(time_us % 1000) *
+                                     load / 1000;
+}
+
+void pushImuSample(const int16_t (&raw)[6]) {
+  // Like the sensor, drop the new samples when the FIFO is full
+  if (imu_fifo_count == IMU_FIFO_PACKETS) return;
+
+  uint8_t *packet = imu_fifo[imu_fifo_count++];
+  std::memset(packet, 0, ICM42605_FIFO_PACKET_SIZE);
+  packet[0] = 0x68;  // accel and gyro data, 20-bit timestamp
+  for (uint8_t i = 0; i < 6; ++i) {
+    packet[1 + 2 * i] = static_cast<uint8_t>(raw[i] >> 8);
+    packet[2 + 2 * i] = static_cast<uint8_t>(raw[i]);
+  }
+  packet[13] = 0;  // 25 degrees
+}
+
+bool completeI2CRead() {
+  const bool pending = read_pending;
+  read_pending = false;
+  return pending;
+}
+
+}  // namespace mock
+
+uint32_t HAL_GetTick(void) {
+  return static_cast<uint32_t>(time_us / 1000);
+}
+
+void HAL_Delay(uint32_t Delay) {
+  mock::advanceTime(Delay * 1000);
+}
+
+void NVIC_SystemReset(void) {}
+
+uint32_t __get_PRIMASK(void) {
+  return primask;
+}
+
+void __set_PRIMASK(uint32_t priMask) {
+  primask = priMask;
+}
+
+void __disable_irq(void) {
+  primask = 1;
+}
+
+void __enable_irq(void) {
+  primask = 0;
+}
+
+void __WFI(void) {}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c,
+                                   uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout) {
+  // The configuration registers read as zeros
+  std::memset(pData, 0, Size);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c,
+                                    uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData,
+                                    uint16_t Size, uint32_t Timeout) {
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c,
+                                      uint16_t DevAddress,
+                                      uint16_t MemAddress,
+                                      uint16_t MemAddSize, uint8_t *pData,
+                                      uint16_t Size) {
+  read_pending = true;
+  if (MemAddress != ICM42605_FIFO_DATA) {
+    std::memset(pData, 0, Size);
+    return HAL_OK;
+  }
+
+  // Drain as many packets as requested, the rest reads as an empty FIFO
+  uint16_t packets = Size / ICM42605_FIFO_PACKET_SIZE;
+  if (packets > imu_fifo_count) packets = imu_fifo_count;
+  const size_t size = packets * ICM42605_FIFO_PACKET_SIZE;
+  std::memcpy(pData, imu_fifo, size);
+  std::memset(pData + size, 0x80, Size - size);
+  std::memmove(imu_fifo, imu_fifo[packets],
+               (imu_fifo_count - packets) * ICM42605_FIFO_PACKET_SIZE);
+  imu_fifo_count -= packets;
+  return HAL_OK;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+#include "stm32f4xx_hal.h"
+
+// Simulation side of the mocked HAL. Nothing advances on its own, the harness
+// moves the time forward and feeds the sensor data explicitly, so every run
+// over the same input is deterministic.
+namespace mock {
+
+// Advances HAL_GetTick(), the SysTick counter and the DWT cycle counter
+void advanceTime(uint32_t us);
+
+// Queues a sample in the simulated IMU FIFO. The raw values are in the order
+// of the sensor registers: accel x, y, z, then gyro x, y, z.
+void pushImuSample(const int16_t (&raw)[6]);
+
+// Finishes the pending interrupt-driven I2C read. Returns false if there was
+// none. The caller has to invoke the completion callback like the I2C
+// interrupt would.
+bool completeI2CRead();
+
+}  // namespace mock
@@ -0,0 +1,428 @@
+// Host-side harness for the firmware control path, built by the native_bench
+// environment. The motor controllers, the IMU receiver, the odometry fusion and
+// the wheel controllers run unchanged on top of the mocked HAL.
+//
+// Usage:
+//   program                 runs the micro-benchmarks
+//   program trace           prints a synthetic trace in the replay format
+//   program replay [FILE]   replays a trace (the synthetic one if no FILE is
+//                           given) and prints the outputs of every update tick
+//
+// The replay of the synthetic trace also compares the odometry with the path
+// the trace was generated from and exits with 1 if they diverge.
+//
+// The trace holds one line per millisecond:
+//   time_ms linear_x angular_z enc_a enc_b enc_c enc_d ax ay az gx gy gz
+// with the commanded speed, the raw counts of the encoder timers (accumulated
+// beyond the 16-bit range) and the raw IMU readings. Lines starting with '#'
+// are ignored.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "diff_drive_lib/diff_drive_controller.hpp"
+
+#include "bench/hal_mock.hpp"
+#include "firmware/configuration.hpp"
+#include "firmware/imu_receiver.hpp"
+#include "firmware/motor_bank.hpp"
+#include "firmware/motor_controller.hpp"
+#include "firmware/odom_fusion.hpp"
+#include "firmware/parameter_values.hpp"
+
+MotorController MotA(MOT_A_CONFIG);
+MotorController MotB(MOT_B_CONFIG);
+MotorController MotC(MOT_C_CONFIG);
+MotorController MotD(MOT_D_CONFIG);
+
+static MotorController *const MOTORS[] = {&MotA, &MotB, &MotC, &MotD};
+static const MotorConfiguration *const MOTOR_CONFIGS[] = {
+    &MOT_A_CONFIG, &MOT_B_CONFIG, &MOT_C_CONFIG, &MOT_D_CONFIG};
+
+static MotorBank motors({&MotA, &MotB, &MotC, &MotD}, PWM_TIMERS);
+static diff_drive_lib::DiffDriveController controller(ROBOT_CONFIG);
+static ImuReceiver imu_receiver(&IMU_I2C);
+static OdomFusion odom_fusion;
+
+static int32_t encoder_counts[MotorBank::MOTOR_COUNT];
+
+struct TraceSample {
+  uint32_t time;
+  float linear_x, angular_z;
+  int32_t encoders[MotorBank::MOTOR_COUNT];
+  int16_t imu[6];
+};
+
+// The defaults of the firmware parameters, scaled for the encoder
+// interpolation like in setup()
+static diff_drive_lib::RobotParams defaultParams() {
+  diff_drive_lib::RobotParams params = ParameterValues();
+  params.wheel_encoder_resolution *= ENCODER_SUBTICKS;
+  params.wheel_pid_p /= ENCODER_SUBTICKS;
+  params.wheel_pid_i /= ENCODER_SUBTICKS;
+  params.wheel_pid_d /= ENCODER_SUBTICKS;
+  return params;
+}
+
+// Sets the counter of an encoder timer the way the hardware would get there,
+// raising the update interrupt if a 16-bit counter wraps
+static void setEncoderCount(uint8_t motor, int32_t count) {
+  TIM_TypeDef *tim = MOTOR_CONFIGS[motor]->enc_tim;
+  const int32_t previous = encoder_counts[motor];
+  encoder_counts[motor] = count;
+
+  if (IS_TIM_32B_COUNTER_INSTANCE(tim)) {
+    tim->CNT = static_cast<uint32_t>(count);
+    return;
+  }
+
+  tim->CNT = static_cast<uint32_t>(count) & 0xFFFFU;
+  if ((previous >> 16) != (count >> 16)) motors.encoderOverflowCallback(tim);
+}
+
+// Called from SysTick in the firmware
+void sampleEncoders() {
+  for (MotorController *motor : MOTORS) motor->sampleEncoder();
+}
+
+// The part of update() driving the wheels and the odometry fusion
+static void controlTick() {
+  motors.latch();
+  controller.update(DEFAULT_UPDATE_PERIOD);
+  motors.commit();
+
+  if (mock::completeI2CRead()) imu_receiver.readCompleteCallback();
+  if (imu_receiver.update()) {
+    odom_fusion.update(imu_receiver.samples, imu_receiver.sample_count,
+                       controller.getOdom());
+  }
+}
+
+static void init() {
+  cycle_counter_init();
+  imu_receiver.init();
+  controller.init(defaultParams());
+}
+
+/* Micro-benchmarks */
+
+template <typename Function>
+static void benchmark(const char *name, uint32_t iterations,
+                      Function &&function) {
+  for (uint32_t i = 0; i < iterations / 10; ++i) function();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; ++i) function();
+  const auto end = std::chrono::steady_clock::now();
+
+  const std::chrono::duration<double, std::nano> elapsed = end - start;
+  std::printf("%-32s %10.1f ns\n", name, elapsed.count() / iterations);
+}
+
+static void runBenchmarks() {
+  static constexpr uint32_t ITERATIONS = 200000;
+  static constexpr int16_t IMU_SAMPLE[6] = {120, -340, -16384, 25, -18, 131};
+
+  controller.setSpeed(0.4F, 0.0F, 0.3F);
+
+  int32_t count = 0;
+  benchmark("sampleEncoder", ITERATIONS, [&] {
+    mock::advanceTime(1000);
+    setEncoderCount(0, count += 3);
+    MotA.sampleEncoder();
+  });
+
+  benchmark("MotorBank::latch", ITERATIONS, [] { motors.latch(); });
+
+  benchmark("MotorBank::commit", ITERATIONS, [] { motors.commit(); });
+
+  motors.setCurrentLimit(1.5F);
+  benchmark("MotorBank::updateCurrentLoop", ITERATIONS,
+            [] { motors.updateCurrentLoop(); });
+  motors.setCurrentLimit(0.0F);
+
+  benchmark("ImuReceiver::update (10 samples)", ITERATIONS, [] {
+    for (uint8_t i = 0; i < 10; ++i) {
+      mock::pushImuSample(IMU_SAMPLE);
+      imu_receiver.dataReadyCallback(micros());
+    }
+    if (mock::completeI2CRead()) imu_receiver.readCompleteCallback();
+    imu_receiver.update();
+  });
+
+  const diff_drive_lib::Odom odom = controller.getOdom();
+  benchmark("OdomFusion::update (10 samples)", ITERATIONS, [&] {
+    odom_fusion.update(imu_receiver.samples, 10, odom);
+  });
+
+  benchmark("update() control path (10 ms)", ITERATIONS, [&] {
+    for (uint8_t ms = 0; ms < DEFAULT_UPDATE_PERIOD; ++ms) {
+      mock::advanceTime(1000);
+      for (uint8_t i = 0; i < MotorBank::MOTOR_COUNT; ++i) {
+        setEncoderCount(i, encoder_counts[i] + (i < 2 ? 3 : -3));
+      }
+      mock::pushImuSample(IMU_SAMPLE);
+      imu_receiver.dataReadyCallback(micros());
+      sampleEncoders();
+    }
+    controlTick();
+  });
+}
+
+/* Traces */
+
+static bool readTraceSample(FILE *file, TraceSample &sample) {
+  char line[256];
+  while (std::fgets(line, sizeof(line), file) != nullptr) {
+    if (line[0] == '#' || line[0] == '\n') continue;
+
+    unsigned long time;
+    long enc[4];
+    int imu[6];
+    const int fields = std::sscanf(
+        line, "%lu %f %f %ld %ld %ld %ld %d %d %d %d %d %d", &time,
+        &sample.linear_x, &sample.angular_z, &enc[0], &enc[1], &enc[2],
+        &enc[3], &imu[0], &imu[1], &imu[2], &imu[3], &imu[4], &imu[5]);
+    if (fields != 13) {
+      std::fprintf(stderr, "Malformed trace line: %s", line);
+      return false;
+    }
+
+    sample.time = static_cast<uint32_t>(time);
+    for (uint8_t i = 0; i < 4; ++i) {
+      sample.encoders[i] = static_cast<int32_t>(enc[i]);
+    }
+    for (uint8_t i = 0; i < 6; ++i) {
+      sample.imu[i] = static_cast<int16_t>(imu[i]);
+    }
+    return true;
+  }
+  return false;
+}
+
+struct Pose {
+  float x, y, yaw;
+};
+
+// Drive of an ideal robot following the commands exactly: standing still,
+// driving straight, turning on an arc and stopping
+class SyntheticTrace {
+ public:
+  static constexpr uint32_t DURATION = 8000;
+  // Last millisecond of the straight segment
+  static constexpr uint32_t STRAIGHT_END = 3999;
+
+  bool next(TraceSample &sample) {
+    if (time_ >= DURATION) return false;
+
+    sample.time = time_;
+    if (time_ < 1000) {
+      sample.linear_x = sample.angular_z = 0.0F;
+    } else if (time_ < 4000) {
+      sample.linear_x = 0.4F;
+      sample.angular_z = 0.0F;
+    } else if (time_ < 7000) {
+      sample.linear_x = 0.2F;
+      sample.angular_z = 0.8F;
+    } else {
+      sample.linear_x = sample.angular_z = 0.0F;
+    }
+
+    // Counts per meter travelled by a wheel
+    const ParameterValues params;
+    const float resolution =
+        params.wheel_encoder_resolution /
+        (2.0F * 3.141592653F * params.robot_wheel_radius);
+    const float half_track = params.robot_wheel_separation / 2.0F;
+    const float left = sample.linear_x - sample.angular_z * half_track;
+    const float right = sample.linear_x + sample.angular_z * half_track;
+    left_ += left * 0.001F * resolution;
+    right_ += right * 0.001F * resolution;
+
+    // The left motors (C and D) are mounted with reversed polarity
+    const int32_t left_cnt = static_cast<int32_t>(std::lround(left_));
+    const int32_t right_cnt = static_cast<int32_t>(std::lround(right_));
+    sample.encoders[0] = right_cnt;
+    sample.encoders[1] = right_cnt;
+    sample.encoders[2] = -left_cnt;
+    sample.encoders[3] = -left_cnt;
+
+    const float yaw = pose_.yaw + sample.angular_z * 0.0005F;
+    pose_.x += sample.linear_x * std::cos(yaw) * 0.001F;
+    pose_.y += sample.linear_x * std::sin(yaw) * 0.001F;
+    pose_.yaw += sample.angular_z * 0.001F;
+
+    // 2 g and 250 dps full scale, the receiver flips the z axes
+    const float gyro_lsb = 32768.0F / 250.0F * 180.0F / 3.141592653F;
+    sample.imu[0] = 0;
+    sample.imu[1] = 0;
+    sample.imu[2] = -16384;
+    sample.imu[3] = 0;
+    sample.imu[4] = 0;
+    sample.imu[5] =
+        static_cast<int16_t>(std::lround(-sample.angular_z * gyro_lsb));
+
+    ++time_;
+    return true;
+  }
+
+  // Pose reached at the end of the last sample
+  const Pose &pose() const { return pose_; }
+
+ private:
+  uint32_t time_ = 0;
+  Pose pose_ = {0.0F, 0.0F, 0.0F};
+  float left_ = 0.0F;
+  float right_ = 0.0F;
+};
+
+static void printTrace() {
+  SyntheticTrace trace;
+  TraceSample s;
+  std::printf(
+      "# time_ms linear_x angular_z enc_a enc_b enc_c enc_d ax ay az gx gy "
+      "gz\n");
+  while (trace.next(s)) {
+    std::printf("%lu %.3f %.3f %ld %ld %ld %ld %d %d %d %d %d %d\n",
+                static_cast<unsigned long>(s.time), s.linear_x, s.angular_z,
+                static_cast<long>(s.encoders[0]),
+                static_cast<long>(s.encoders[1]),
+                static_cast<long>(s.encoders[2]),
+                static_cast<long>(s.encoders[3]), s.imu[0], s.imu[1],
+                s.imu[2], s.imu[3], s.imu[4], s.imu[5]);
+  }
+}
+
+static void hash(uint32_t &state, const void *data, size_t size) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; ++i) state = (state ^ bytes[i]) * 16777619U;
+}
+
+// Feeds the samples through the control path on the firmware timeline and
+// prints what the firmware would output on every update tick. The final hash
+// covers all the outputs, so two runs can be compared at a glance. The
+// observer is called after every tick with the time of its sample.
+template <typename Source, typename Observer>
+static void replay(Source &&next_sample, Observer &&observe) {
+  std::printf(
+      "time_ms,ccr_a,ccr_b,ccr_c,ccr_d,odom_x,odom_y,odom_yaw,"
+      "fused_x,fused_y,fused_yaw\n");
+
+  uint32_t digest = 2166136261U;
+  uint32_t ticks = 0;
+  float linear_x = 0.0F, angular_z = 0.0F;
+  TraceSample s;
+  while (next_sample(s)) {
+    mock::advanceTime(1000);
+    for (uint8_t i = 0; i < MotorBank::MOTOR_COUNT; ++i) {
+      setEncoderCount(i, s.encoders[i]);
+    }
+    mock::pushImuSample(s.imu);
+    imu_receiver.dataReadyCallback(micros());
+    sampleEncoders();
+
+    if (s.time % DEFAULT_UPDATE_PERIOD != 0) continue;
+
+    // Like a host publishing cmd_vel at 10 Hz and on every change
+    if (s.linear_x != linear_x || s.angular_z != angular_z ||
+        s.time % 100 == 0) {
+      linear_x = s.linear_x;
+      angular_z = s.angular_z;
+      controller.setSpeed(linear_x, 0.0F, angular_z);
+    }
+
+    controlTick();
+    ++ticks;
+
+    const uint32_t ccr[] = {*MOT_A_CONFIG.pwm_ccr, *MOT_B_CONFIG.pwm_ccr,
+                            *MOT_C_CONFIG.pwm_ccr, *MOT_D_CONFIG.pwm_ccr};
+    const diff_drive_lib::Odom odom = controller.getOdom();
+    const float fused[] = {odom_fusion.pose_x, odom_fusion.pose_y,
+                           odom_fusion.pose_yaw};
+    hash(digest, &imu_receiver.time, sizeof(imu_receiver.time));
+    hash(digest, ccr, sizeof(ccr));
+    hash(digest, &odom, sizeof(odom));
+    hash(digest, fused, sizeof(fused));
+
+    std::printf("%lu,%lu,%lu,%lu,%lu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                static_cast<unsigned long>(s.time),
+                static_cast<unsigned long>(ccr[0]),
+                static_cast<unsigned long>(ccr[1]),
+                static_cast<unsigned long>(ccr[2]),
+                static_cast<unsigned long>(ccr[3]), odom.pose_x, odom.pose_y,
+                odom.pose_yaw, fused[0], fused[1], fused[2]);
+
+    observe(s.time, odom);
+  }
+
+  std::printf("# %lu ticks, digest %08lx\n", static_cast<unsigned long>(ticks),
+              static_cast<unsigned long>(digest));
+}
+
+static bool expectNear(const char *name, float value, float expected) {
+  // Meters or radians, a few ticks of lag on the arc stay well within it
+  static constexpr float TOLERANCE = 0.05F;
+  if (std::fabs(value - expected) <= TOLERANCE) return true;
+  std::fprintf(stderr, "%s is %.4f, expected %.4f\n", name, value, expected);
+  return false;
+}
+
+// Replays the synthetic trace and checks the wheel odometry at the end of the
+// straight segment and the fused pose at the end of the trace. The wheel
+// odometry yaw is not checked, as the trace does not model the slip covered
+// by robot_angular_velocity_multiplier.
+static bool replaySynthetic() {
+  SyntheticTrace trace;
+  bool ok = true;
+  replay([&](TraceSample &s) { return trace.next(s); },
+         [&](uint32_t time, const diff_drive_lib::Odom &odom) {
+           const Pose &pose = trace.pose();
+           // The ticks fall on multiples of the update period
+           const uint32_t next_tick = time + DEFAULT_UPDATE_PERIOD;
+           if (time <= SyntheticTrace::STRAIGHT_END &&
+               next_tick > SyntheticTrace::STRAIGHT_END) {
+             ok &= expectNear("odom_x", odom.pose_x, pose.x);
+             ok &= expectNear("odom_y", odom.pose_y, pose.y);
+           }
+           if (next_tick >= SyntheticTrace::DURATION) {
+             ok &= expectNear("fused_x", odom_fusion.pose_x, pose.x);
+             ok &= expectNear("fused_y", odom_fusion.pose_y, pose.y);
+             ok &= expectNear("fused_yaw", odom_fusion.pose_yaw, pose.yaw);
+           }
+         });
+  std::printf("# path check %s\n", ok ? "passed" : "failed");
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  init();
+
+  if (argc < 2) {
+    runBenchmarks();
+    return 0;
+  }
+
+  if (std::strcmp(argv[1], "trace") == 0) {
+    printTrace();
+    return 0;
+  }
+
+  if (std::strcmp(argv[1], "replay") == 0) {
+    if (argc < 3) return replaySynthetic() ? 0 : 1;
+
+    FILE *file = std::fopen(argv[2], "r");
+    if (file == nullptr) {
+      std::fprintf(stderr, "Cannot open %s\n", argv[2]);
+      return 1;
+    }
+    replay([&](TraceSample &s) { return readTraceSample(file, s); },
+           [](uint32_t, const diff_drive_lib::Odom &) {});
+    std::fclose(file);
+    return 0;
+  }
+
+  std::fprintf(stderr, "Usage: %s [trace | replay [FILE]]\n", argv[0]);
+  return 1;
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+// Host-side replacement of the STM32Cube HAL used by the native_bench
+// environment. It only covers what the firmware control path touches. The
+// peripheral registers are plain structures in RAM, so the code under test
+// accesses them exactly as on the MCU and the harness can read and write them
+// to simulate the hardware.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __I volatile const
+#define __IO volatile
+
+typedef enum {
+  HAL_OK = 0x00U,
+  HAL_ERROR = 0x01U,
+  HAL_BUSY = 0x02U,
+  HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+
+/* Register blocks */
+
+typedef struct {
+  __IO uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+  __IO uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC,
+      ARR, RCR, CCR1, CCR2, CCR3, CCR4, BDTR, DCR, DMAR, OR;
+} TIM_TypeDef;
+
+typedef struct {
+  __IO uint32_t CR, PLLCFGR, CFGR, CIR, AHB1RSTR, AHB2RSTR, RESERVED0[2],
+      APB1RSTR, APB2RSTR, RESERVED1[2], AHB1ENR, AHB2ENR, RESERVED2[2],
+      APB1ENR, APB2ENR, RESERVED3[2], AHB1LPENR, AHB2LPENR, RESERVED4[2],
+      APB1LPENR, APB2LPENR, RESERVED5[2], BDCR, CSR;
+} RCC_TypeDef;
+
+typedef struct {
+  __IO uint32_t KR, PR, RLR, SR;
+} IWDG_TypeDef;
+
+typedef struct {
+  __IO uint32_t CTRL, CYCCNT;
+} DWT_Type;
+
+typedef struct {
+  __IO uint32_t DHCSR, DCRSR, DCRDR, DEMCR;
+} CoreDebug_Type;
+
+typedef struct {
+  __IO uint32_t CTRL, LOAD, VAL, CALIB;
+} SysTick_Type;
+
+typedef struct {
+  __IO uint32_t CPUID, ICSR, VTOR, AIRCR, SCR;
+} SCB_Type;
+
+extern GPIO_TypeDef mock_GPIOA, mock_GPIOB, mock_GPIOC;
+extern TIM_TypeDef mock_TIM1, mock_TIM2, mock_TIM3, mock_TIM4, mock_TIM5,
+    mock_TIM9, mock_TIM11;
+extern RCC_TypeDef mock_RCC;
+extern IWDG_TypeDef mock_IWDG;
+extern DWT_Type mock_DWT;
+extern CoreDebug_Type mock_CoreDebug;
+extern SysTick_Type mock_SysTick;
+extern SCB_Type mock_SCB;
+
+#define GPIOA (&mock_GPIOA)
+#define GPIOB (&mock_GPIOB)
+#define GPIOC (&mock_GPIOC)
+#define TIM1 (&mock_TIM1)
+#define TIM2 (&mock_TIM2)
+#define TIM3 (&mock_TIM3)
+#define TIM4 (&mock_TIM4)
+#define TIM5 (&mock_TIM5)
+#define TIM9 (&mock_TIM9)
+#define TIM11 (&mock_TIM11)
+#define RCC (&mock_RCC)
+#define IWDG (&mock_IWDG)
+#define DWT (&mock_DWT)
+#define CoreDebug (&mock_CoreDebug)
+#define SysTick (&mock_SysTick)
+#define SCB (&mock_SCB)
+
+#define IS_TIM_32B_COUNTER_INSTANCE(INSTANCE) \
+  (((INSTANCE) == TIM2) || ((INSTANCE) == TIM5))
+
+/* Register bits */
+
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_1 ((uint16_t)0x0002)
+#define GPIO_PIN_2 ((uint16_t)0x0004)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+#define GPIO_PIN_6 ((uint16_t)0x0040)
+#define GPIO_PIN_7 ((uint16_t)0x0080)
+#define GPIO_PIN_8 ((uint16_t)0x0100)
+#define GPIO_PIN_9 ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_11 ((uint16_t)0x0800)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+
+#define TIM_CR1_CEN (1U << 0)
+#define TIM_CR1_UDIS (1U << 1)
+#define TIM_SR_UIF (1U << 0)
+#define TIM_FLAG_UPDATE TIM_SR_UIF
+
+#define RCC_CSR_RMVF (1U << 24)
+#define RCC_CSR_BORRSTF (1U << 25)
+#define RCC_CSR_PINRSTF (1U << 26)
+#define RCC_CSR_PORRSTF (1U << 27)
+#define RCC_CSR_SFTRSTF (1U << 28)
+#define RCC_CSR_IWDGRSTF (1U << 29)
+#define RCC_CSR_WWDGRSTF (1U << 30)
+#define RCC_CSR_LPWRRSTF (1U << 31)
+
+#define IWDG_RLR_RL 0xFFFU
+
+#define DWT_CTRL_CYCCNTENA_Msk (1U << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1U << 24)
+#define SCB_ICSR_PENDSTSET_Msk (1U << 26)
+
+#define FLASH_SECTOR_5 5U
+
+#define I2C_MEMADD_SIZE_8BIT 0x00000001U
+
+/* Peripheral handles */
+
+typedef struct {
+  TIM_TypeDef *Instance;
+} TIM_HandleTypeDef;
+
+typedef struct {
+  uint32_t Timing;
+} I2C_HandleTypeDef;
+
+typedef struct {
+  uint32_t BaudRate;
+} UART_HandleTypeDef;
+
+typedef struct {
+  uint32_t ClockPrescaler;
+} ADC_HandleTypeDef;
+
+#define __HAL_TIM_GET_COUNTER(h) ((h)->Instance->CNT)
+#define __HAL_TIM_GET_FLAG(h, f) (((h)->Instance->SR & (f)) == (f))
+#define __HAL_DBGMCU_FREEZE_IWDG() ((void)0)
+
+/* Core and HAL functions */
+
+extern uint32_t SystemCoreClock;
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+void NVIC_SystemReset(void);
+
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+void __disable_irq(void);
+void __enable_irq(void);
+void __WFI(void);
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c,
+                                   uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c,
+                                    uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData,
+                                    uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c,
+                                      uint16_t DevAddress,
+                                      uint16_t MemAddress,
+                                      uint16_t MemAddSize, uint8_t *pData,
+                                      uint16_t Size);
+
+#ifdef __cplusplus
+}
+#endif
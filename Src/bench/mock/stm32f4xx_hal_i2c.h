@@ -0,0 +1,3 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
@@ -1,4 +1,5 @@
 #include "firmware/imu_receiver.hpp"
+#include "firmware/hal_compat.hpp"
 
 static constexpr float PI = 3.141592653F;
 static constexpr float GRAVITATIONAL_ACCELERATION = 9.80665F;
@@ -6,27 +7,153 @@ static constexpr float DEGREE_TO_RADIAN = 2.0F * PI / 360.0F;
 static constexpr float TEMP_RESOLUTION = 1.0F / 132.48F;
 static constexpr float TEMP_OFFSET = 25.0F;
 
+// Sample periods measured from the data-ready interrupts are trusted only
+// within the tolerance of the sensor clock
+static constexpr uint32_t MIN_SAMPLE_PERIOD_US =
+    ImuReceiver::SAMPLE_PERIOD_US * 9 / 10;
+static constexpr uint32_t MAX_SAMPLE_PERIOD_US =
+    ImuReceiver::SAMPLE_PERIOD_US * 11 / 10;
+
 void ImuReceiver::init() {
   icm_.init(AFS_2G, GFS_250DPS, AODR_1000Hz, GODR_1000Hz);
+  icm_.enableFifo();
+  icm_.enableDataReadyInterrupt();
 
-  ares_ = icm_.getAres(AFS_2G);
-  gres_ = icm_.getGres(GFS_250DPS);
+  // Fold the unit conversions into a single factor per sensor
+  accel_scale_ = icm_.getAres(AFS_2G) * GRAVITATIONAL_ACCELERATION;
+  gyro_scale_ = icm_.getGres(GFS_250DPS) * DEGREE_TO_RADIAN;
 
   temp = 0.0;
   ax = ay = az = 0.0;
   gx = gy = gz = 0.0;
+  sample_count = 0;
+}
+
+bool ImuReceiver::update() {
+  bool new_data = icm_.fifoDataReady();
+
+  if (new_data) {
+    int16_t ICM42605Data[7];
+    sample_count = 0;
+    for (int32_t& sum : raw_sum_) sum = 0;
+    for (uint8_t i = 0; i < MAX_SAMPLES; ++i) {
+      const uint8_t* packet = &fifo_buffer_[i * ICM42605_FIFO_PACKET_SIZE];
+      if (ICM42605::readFifoPacket(packet, ICM42605Data)) {
+        convertSample(ICM42605Data, samples[sample_count++]);
+        for (uint8_t ch = 0; ch < 7; ++ch) raw_sum_[ch] += ICM42605Data[ch];
+      }
+    }
+
+    stampSamples();
+  }
+
+  // The buffer is free again, queue the next transfer
+  startRead();
+
+  if (!new_data || sample_count == 0) return false;
+
+  // The raw values are summed exactly in integers, so the average needs only
+  // one multiplication per channel
+  const float scale = 1.0F / static_cast<float>(sample_count);
+  const float accel_scale = accel_scale_ * scale;
+  const float gyro_scale = gyro_scale_ * scale;
+  temp = static_cast<float>(raw_sum_[0]) * (TEMP_RESOLUTION * scale) +
+         TEMP_OFFSET;
+  ax = static_cast<float>(raw_sum_[2]) * accel_scale;
+  ay = static_cast<float>(raw_sum_[1]) * accel_scale;
+  az = -static_cast<float>(raw_sum_[3]) * accel_scale;
+  gx = static_cast<float>(raw_sum_[5]) * gyro_scale;
+  gy = static_cast<float>(raw_sum_[4]) * gyro_scale;
+  gz = -static_cast<float>(raw_sum_[6]) * gyro_scale;
+  const uint32_t span = samples[sample_count - 1].time - samples[0].time;
+  time = samples[0].time + span / 2;
+
+  return true;
+}
+
+void ImuReceiver::stampSamples() {
+  if (read_count_ == 0) {
+    // No data-ready interrupts, the newest sample is assumed to be the one
+    // taken right before the transfer was started
+    for (uint8_t i = 0; i < sample_count; ++i) {
+      samples[i].time = read_time_ - (sample_count - 1 - i) * sample_period_;
+    }
+    return;
+  }
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const uint32_t ready_count = data_ready_count_;
+  __set_PRIMASK(primask);
+
+  // A transfer that drained the FIFO got every sample signalled before it was
+  // started and none that has not been signalled yet. Otherwise the count is
+  // off, as the FIFO has overflowed or held samples from before the interrupts
+  // were enabled, and it is realigned.
+  if (sample_count < MAX_SAMPLES) {
+    uint32_t end = consumed_count_ + sample_count;
+    if (static_cast<int32_t>(end - read_count_) < 0) {
+      end = read_count_;
+    } else if (static_cast<int32_t>(end - ready_count) > 0) {
+      end = ready_count;
+    }
+    consumed_count_ = end - sample_count;
+  }
+
+  // The samples without a recorded interrupt time, not signalled yet or with
+  // the time already overwritten, are placed from the nearest recorded one by
+  // the sample period. The oldest entry can be overwritten while this runs.
+  const uint32_t oldest =
+      ready_count - (ready_count < READY_TIMES_SIZE ? ready_count
+                                                    : READY_TIMES_SIZE - 1);
+  for (uint8_t i = 0; i < sample_count; ++i) {
+    const uint32_t number = consumed_count_ + i;
+    uint32_t ref = number;
+    if (static_cast<int32_t>(ref - oldest) < 0) {
+      ref = oldest;
+    } else if (static_cast<int32_t>(ref - ready_count) >= 0) {
+      ref = ready_count - 1;
+    }
+    samples[i].time =
+        data_ready_times_[ref % READY_TIMES_SIZE] +
+        static_cast<uint32_t>(static_cast<int32_t>(number - ref) *
+                              static_cast<int32_t>(sample_period_));
+  }
+  consumed_count_ += sample_count;
+}
+
+void ImuReceiver::startRead() {
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const uint32_t ready_time = data_ready_time_;
+  const uint32_t ready_count = data_ready_count_;
+  __set_PRIMASK(primask);
+
+  if (!icm_.startReadFifo(fifo_buffer_, MAX_SAMPLES)) return;
+
+  if (ready_count == read_count_) {
+    read_time_ = micros();
+    sample_period_ = SAMPLE_PERIOD_US;
+    return;
+  }
+
+  if (read_count_ != 0) {
+    const uint32_t period =
+        (ready_time - read_time_) / (ready_count - read_count_);
+    if (period >= MIN_SAMPLE_PERIOD_US && period <= MAX_SAMPLE_PERIOD_US) {
+      sample_period_ = period;
+    }
+  }
+  read_time_ = ready_time;
+  read_count_ = ready_count;
 }
 
-void ImuReceiver::update() {
-  int16_t ICM42605Data[7];
-  icm_.readData(ICM42605Data);
-
-  temp = static_cast<float>(ICM42605Data[0]) * TEMP_RESOLUTION + TEMP_OFFSET;
-  ax = static_cast<float>(ICM42605Data[2]) * ares_ * GRAVITATIONAL_ACCELERATION;
-  ay = static_cast<float>(ICM42605Data[1]) * ares_ * GRAVITATIONAL_ACCELERATION;
-  az =
-      -static_cast<float>(ICM42605Data[3]) * ares_ * GRAVITATIONAL_ACCELERATION;
-  gx = static_cast<float>(ICM42605Data[5]) * gres_ * DEGREE_TO_RADIAN;
-  gy = static_cast<float>(ICM42605Data[4]) * gres_ * DEGREE_TO_RADIAN;
-  gz = -static_cast<float>(ICM42605Data[6]) * gres_ * DEGREE_TO_RADIAN;
+void ImuReceiver::convertSample(const int16_t* data, ImuSample& sample) const {
+  sample.temp = static_cast<float>(data[0]) * TEMP_RESOLUTION + TEMP_OFFSET;
+  sample.ax = static_cast<float>(data[2]) * accel_scale_;
+  sample.ay = static_cast<float>(data[1]) * accel_scale_;
+  sample.az = -static_cast<float>(data[3]) * accel_scale_;
+  sample.gx = static_cast<float>(data[5]) * gyro_scale_;
+  sample.gy = static_cast<float>(data[4]) * gyro_scale_;
+  sample.gz = -static_cast<float>(data[6]) * gyro_scale_;
 }
\ No newline at end of file
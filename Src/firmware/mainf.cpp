@@ -1,11 +1,17 @@
+#include <atomic>
 #include <cstdio>
 #include <cstring>
-#include <string>
-
-#include <ros.h>
+#include <new>
+#include <type_traits>
 
 #include <geometry_msgs/Twist.h>
+#include <leo_msgs/BlackBoxChunk.h>
+#include <leo_msgs/FirmwareState.h>
+#include <leo_msgs/FirmwareStateQuantized.h>
 #include <leo_msgs/Imu.h>
+#include <leo_msgs/ImuBatch.h>
+#include <leo_msgs/SetBaudRate.h>
+#include <leo_msgs/SetParams.h>
 #include <leo_msgs/WheelOdom.h>
 #include <leo_msgs/WheelOdomMecanum.h>
 #include <leo_msgs/WheelStates.h>
@@ -14,13 +20,24 @@
 
 #include "mainf.h"
 
+#ifndef FIRMWARE_DRIVE_MECANUM
 #include "diff_drive_lib/diff_drive_controller.hpp"
+#endif
+#ifndef FIRMWARE_DRIVE_DIFF
 #include "diff_drive_lib/mecanum_controller.hpp"
+#endif
 #include "diff_drive_lib/wheel_controller.hpp"
 
+#include "firmware/black_box.hpp"
 #include "firmware/configuration.hpp"
 #include "firmware/imu_receiver.hpp"
+#include "firmware/mailbox.hpp"
+#include "firmware/motor_bank.hpp"
+#include "firmware/odom_fusion.hpp"
 #include "firmware/parameters.hpp"
+#include "firmware/profiler.hpp"
+#include "firmware/ros.hpp"
+#include "firmware/spsc_queue.hpp"
 
 static ros::NodeHandle nh;
 static bool configured = false;
@@ -30,44 +47,215 @@ static std_msgs::Float32 battery_averaged;
 static ros::Publisher battery_pub("firmware/battery", &battery);
 static ros::Publisher battery_averaged_pub("firmware/battery_averaged",
                                            &battery);
-static diff_drive_lib::CircularBuffer<float> battery_buffer_(
-    BATTERY_BUFFER_SIZE);
-static bool publish_battery = false;
+static BatteryFilter battery_filter;
+
+struct BatterySample {
+  float voltage;
+  float voltage_averaged;
+};
+static SpscQueue<BatterySample, PUBLISH_QUEUE_SIZE> battery_queue;
 
+#ifndef FIRMWARE_DRIVE_MECANUM
 static leo_msgs::WheelOdom wheel_odom;
 static ros::Publisher wheel_odom_pub("firmware/wheel_odom", &wheel_odom);
+static SpscQueue<leo_msgs::WheelOdom, PUBLISH_QUEUE_SIZE> wheel_odom_queue;
+#endif
+#ifndef FIRMWARE_DRIVE_DIFF
 static leo_msgs::WheelOdomMecanum wheel_odom_mecanum;
 static ros::Publisher wheel_odom_mecanum_pub("firmware/wheel_odom_mecanum",
                                              &wheel_odom_mecanum);
-static bool publish_wheel_odom = false;
+static SpscQueue<leo_msgs::WheelOdomMecanum, PUBLISH_QUEUE_SIZE>
+    wheel_odom_mecanum_queue;
+#endif
+
+// The fused odometry uses the mecanum message for both drive types, as it has
+// all the fields
+static leo_msgs::WheelOdomMecanum odom_fused;
+static ros::Publisher odom_fused_pub("firmware/odom_fused", &odom_fused);
+static SpscQueue<leo_msgs::WheelOdomMecanum, PUBLISH_QUEUE_SIZE>
+    odom_fused_queue;
+static OdomFusion odom_fusion;
+static std::atomic<bool> odom_fusion_reset_request{false};
 
 static leo_msgs::WheelStates wheel_states;
 static ros::Publisher wheel_states_pub("firmware/wheel_states", &wheel_states);
-static bool publish_wheel_states = false;
+static SpscQueue<leo_msgs::WheelStates, PUBLISH_QUEUE_SIZE>
+    wheel_states_queue;
 
 static leo_msgs::Imu imu;
 static ros::Publisher imu_pub("firmware/imu", &imu);
-static bool publish_imu = false;
+static SpscQueue<leo_msgs::Imu, PUBLISH_QUEUE_SIZE> imu_queue;
+
+static leo_msgs::ImuBatch imu_batch;
+static ros::Publisher imu_batch_pub("firmware/imu_batch", &imu_batch);
+static ros::Time imu_batch_stamp[IMU_BATCH_SIZE];
+static float imu_batch_temperature[IMU_BATCH_SIZE];
+static float imu_batch_gyro_x[IMU_BATCH_SIZE];
+static float imu_batch_gyro_y[IMU_BATCH_SIZE];
+static float imu_batch_gyro_z[IMU_BATCH_SIZE];
+static float imu_batch_accel_x[IMU_BATCH_SIZE];
+static float imu_batch_accel_y[IMU_BATCH_SIZE];
+static float imu_batch_accel_z[IMU_BATCH_SIZE];
+static uint8_t imu_batch_size = 0;
+
+struct ImuBatchEntry {
+  ros::Time stamp;
+  ImuSample sample;
+};
+static SpscQueue<ImuBatchEntry, IMU_BATCH_QUEUE_SIZE> imu_batch_queue;
+
+static leo_msgs::FirmwareState state;
+static ros::Publisher state_pub("firmware/state", &state);
+static SpscQueue<leo_msgs::FirmwareState, PUBLISH_QUEUE_SIZE> state_queue;
+static leo_msgs::FirmwareStateQuantized state_quantized;
+static ros::Publisher state_quantized_pub("firmware/state_quantized",
+                                          &state_quantized);
+static SpscQueue<leo_msgs::FirmwareStateQuantized, PUBLISH_QUEUE_SIZE>
+    state_quantized_queue;
+
+// Units of the firmware/state_quantized values
+static constexpr float STATE_BATTERY_SCALE = 1000.0F;     // mV
+static constexpr float STATE_VELOCITY_SCALE = 1000.0F;    // mm/s, mrad/s
+static constexpr float STATE_TORQUE_SCALE = 1000.0F;      // mNm
+static constexpr float STATE_PWM_SCALE = 100.0F;          // 0.01 %
+static constexpr float STATE_TEMPERATURE_SCALE = 100.0F;  // 0.01 deg C
+static constexpr float STATE_GYRO_SCALE = 5000.0F;        // 0.2 mrad/s
+static constexpr float STATE_ACCEL_SCALE = 1000.0F;       // mm/s^2
+
+// Units of the black box records not shared with firmware/state_quantized
+static constexpr float BLACK_BOX_CURRENT_SCALE = 1000.0F;  // mA
+static constexpr float BLACK_BOX_GYRO_SCALE = 1000.0F;     // mrad/s
+
+static BlackBox<BLACK_BOX_SIZE, BLACK_BOX_POST_TRIGGER> black_box;
+static leo_msgs::BlackBoxChunk black_box_chunk;
+static ros::Publisher black_box_pub("firmware/black_box", &black_box_chunk);
+static int32_t black_box_time_offset[BLACK_BOX_CHUNK_SIZE];
+static int16_t black_box_encoder_delta[BLACK_BOX_CHUNK_SIZE * 4];
+static int16_t black_box_pwm_duty[BLACK_BOX_CHUNK_SIZE * 4];
+static uint16_t black_box_current[BLACK_BOX_CHUNK_SIZE * 4];
+static int16_t black_box_gyro[BLACK_BOX_CHUNK_SIZE * 3];
+static uint16_t black_box_battery[BLACK_BOX_CHUNK_SIZE];
+
+// Velocity command received in loop() and applied at the next update() tick
+struct SpeedCommand {
+  float linear_x;
+  float linear_y;
+  float angular_z;
+  uint32_t received;  // cycles() at the arrival of the command
+};
+static Mailbox<SpeedCommand> cmd_vel_mailbox;
+
+// Delays between the arrival and the application of the velocity commands
+struct CommandLatency {
+  void add(uint32_t latency) {
+    if (count == 0 || latency < min) min = latency;
+    if (latency > max) max = latency;
+    total += latency;
+    ++count;
+  }
+
+  uint32_t min = 0;
+  uint32_t max = 0;
+  uint64_t total = 0;
+  uint32_t count = 0;
+};
+static CommandLatency cmd_vel_latency;
 
 static bool reset_request = false;
+static const char *last_reset_cause = "unknown";
+
+// Set by every completed update() tick, the watchdog is fed only if it is set
+static std::atomic<bool> update_progress{false};
+static volatile uint32_t late_ticks = 0;
+static volatile uint32_t overrun_ticks = 0;
+
+// Set when no commands have come for the input timeout, the motor drivers are
+// asleep and loop() waits for interrupts instead of polling
+static bool idle = false;
+static uint32_t last_command_time = 0;
+static bool params_fetched = false;
+
+// Parameters applied at the next update() tick
+static Mailbox<Parameters> params_mailbox;
+
+static volatile uint32_t pending_baud_rate = 0;
+// Set by the UART error interrupt, the link is restarted by loop()
+static volatile bool uart_error = false;
+static bool baud_rate_confirmed = true;
+static uint32_t baud_rate_link_time = 0;
 
 MotorController MotA(MOT_A_CONFIG);
 MotorController MotB(MOT_B_CONFIG);
 MotorController MotC(MOT_C_CONFIG);
 MotorController MotD(MOT_D_CONFIG);
-
+static MotorBank motors({&MotA, &MotB, &MotC, &MotD}, PWM_TIMERS);
+
+// Same order of the wheels as in firmware/wheel_states
+static const char *const wheel_names[] = {"FL", "RL", "FR", "RR"};
+static MotorController *const wheel_motors[] = {&MotC, &MotD, &MotA, &MotB};
+
+// Storage large enough for the controller types built in, so that the one
+// selected by the parameters can be constructed without using the heap
+#if defined(FIRMWARE_DRIVE_DIFF)
+static std::aligned_union<0, diff_drive_lib::DiffDriveController>::type
+    controller_storage;
+#elif defined(FIRMWARE_DRIVE_MECANUM)
+static std::aligned_union<0, diff_drive_lib::MecanumController>::type
+    controller_storage;
+#else
+static std::aligned_union<0, diff_drive_lib::DiffDriveController,
+                          diff_drive_lib::MecanumController>::type
+    controller_storage;
+#endif
 static diff_drive_lib::RobotController *controller;
 static ImuReceiver imu_receiver(&IMU_I2C);
 
+// Numbers of update() calls between the periodic tasks
+struct TaskDividers {
+  explicit constexpr TaskDividers(uint16_t update_period)
+      : battery_filter(BATTERY_FILTER_PERIOD / update_period),
+        led_low_battery(LED_LOW_BATTERY_PERIOD / update_period),
+        led_disconnected(LED_DISCONNECTED_PERIOD / update_period),
+        battery_pub(BATTERY_PUB_PERIOD / update_period),
+        joints_pub(JOINTS_PUB_PERIOD / update_period),
+        odom_pub(ODOM_PUB_PERIOD / update_period),
+        imu_pub(IMU_PUB_PERIOD / update_period),
+        state_pub(STATE_PUB_PERIOD / update_period) {}
+
+  uint16_t battery_filter;
+  uint16_t led_low_battery;
+  uint16_t led_disconnected;
+  uint16_t battery_pub;
+  uint16_t joints_pub;
+  uint16_t odom_pub;
+  uint16_t imu_pub;
+  uint16_t state_pub;
+};
+
+static uint16_t update_period = DEFAULT_UPDATE_PERIOD;
+static TaskDividers dividers(DEFAULT_UPDATE_PERIOD);
+
 Parameters params;
 
+static void commandReceived() {
+  last_command_time = time();
+  if (idle) {
+    motors.wake();
+    idle = false;
+  }
+}
+
 void cmdVelCallback(const geometry_msgs::Twist &msg) {
-  controller->setSpeed(msg.linear.x, msg.linear.y, msg.angular.z);
+  commandReceived();
+  cmd_vel_mailbox.post({static_cast<float>(msg.linear.x),
+                        static_cast<float>(msg.linear.y),
+                        static_cast<float>(msg.angular.z), cycles()});
 }
 
 void resetOdometryCallback(const std_srvs::TriggerRequest &req,
                            std_srvs::TriggerResponse &res) {
   controller->resetOdom();
+  odom_fusion_reset_request = true;
   res.success = true;
 }
 
@@ -90,44 +278,229 @@ void getBoardTypeCallback(const std_srvs::TriggerRequest &req,
   res.success = true;
 }
 
+void getDiagnosticsCallback(const std_srvs::TriggerRequest &req,
+                            std_srvs::TriggerResponse &res) {
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const CommandLatency latency = cmd_vel_latency;
+  __set_PRIMASK(primask);
+
+  const uint32_t cycles_per_us = SystemCoreClock / 1000000;
+  const uint32_t mean =
+      latency.count > 0 ? static_cast<uint32_t>(latency.total / latency.count)
+                        : 0;
+
+  uint32_t odom_dropped = odom_fused_queue.dropped();
+#ifndef FIRMWARE_DRIVE_MECANUM
+  odom_dropped += wheel_odom_queue.dropped();
+#endif
+#ifndef FIRMWARE_DRIVE_DIFF
+  odom_dropped += wheel_odom_mecanum_queue.dropped();
+#endif
+
+  static char message[448];
+  const int length = std::snprintf(
+      message, sizeof(message),
+      "dropped messages: battery=%lu wheel_odom=%lu "
+      "wheel_states=%lu imu=%lu imu_batch=%lu state=%lu\n"
+      "cmd_vel latency [us]: min=%lu mean=%lu max=%lu count=%lu\n"
+      "reset cause: %s, late ticks: %lu, overrun ticks: %lu\n"
+      "motor faults [count@last ms]:",
+      static_cast<unsigned long>(battery_queue.dropped()),
+      static_cast<unsigned long>(odom_dropped),
+      static_cast<unsigned long>(wheel_states_queue.dropped()),
+      static_cast<unsigned long>(imu_queue.dropped()),
+      static_cast<unsigned long>(imu_batch_queue.dropped()),
+      static_cast<unsigned long>(state_queue.dropped() +
+                                 state_quantized_queue.dropped()),
+      static_cast<unsigned long>(latency.min / cycles_per_us),
+      static_cast<unsigned long>(mean / cycles_per_us),
+      static_cast<unsigned long>(latency.max / cycles_per_us),
+      static_cast<unsigned long>(latency.count), last_reset_cause,
+      static_cast<unsigned long>(late_ticks),
+      static_cast<unsigned long>(overrun_ticks));
+
+  size_t offset = length > 0 ? static_cast<size_t>(length) : 0;
+  for (uint8_t i = 0; i < 4 && offset < sizeof(message); ++i) {
+    offset += std::snprintf(
+        message + offset, sizeof(message) - offset, " %s=%lu@%lu",
+        wheel_names[i],
+        static_cast<unsigned long>(wheel_motors[i]->getFaultCount()),
+        static_cast<unsigned long>(wheel_motors[i]->getLastFaultTime()));
+  }
+
+  res.message = message;
+  res.success = true;
+}
+
+#ifdef FIRMWARE_PROFILING
+void getProfilingCallback(const std_srvs::TriggerRequest &req,
+                          std_srvs::TriggerResponse &res) {
+  static char message[448];
+  profiler.report(message, sizeof(message));
+  res.message = message;
+  res.success = true;
+}
+#endif
+
+// Expands to a string literal with the name of a wheel topic
+#define WHEEL_TOPIC(wheel_name, topic) "firmware/wheel_" wheel_name "/" topic
+
+// The controllers work on interpolated encoder counts
+static void scaleToSubticks(Parameters &parameters) {
+  parameters.wheel_encoder_resolution *= ENCODER_SUBTICKS;
+  parameters.wheel_pid_p /= ENCODER_SUBTICKS;
+  parameters.wheel_pid_i /= ENCODER_SUBTICKS;
+  parameters.wheel_pid_d /= ENCODER_SUBTICKS;
+}
+
+enum class ParamsUpdate { UNCHANGED, APPLIED, RESTART };
+
+// Saves the new parameters in the flash and hands them over to update(), or
+// requests a restart if they can't be applied while running
+static ParamsUpdate applyParameters(const Parameters &new_params) {
+  // Erasing the flash sector stalls the CPU, interrupts included, for over
+  // a second. The motors are stopped for it and, as the control loop misses
+  // its ticks, the board is restarted afterwards.
+  if (new_params.saveNeedsErase()) {
+    configured = false;
+    motors.stop();
+    motors.sleep();
+    watchdog_init(WATCHDOG_BLOCKING_TIMEOUT);
+    new_params.saveCached();
+    watchdog_init(WATCHDOG_TIMEOUT);
+    reset_request = true;
+    return ParamsUpdate::RESTART;
+  }
+
+  if (!new_params.saveCached()) return ParamsUpdate::UNCHANGED;
+
+  if (new_params.needsRestart(params)) {
+    reset_request = true;
+    return ParamsUpdate::RESTART;
+  }
+
+  Parameters scaled_params = new_params;
+  scaleToSubticks(scaled_params);
+  params_mailbox.post(scaled_params);
+  return ParamsUpdate::APPLIED;
+}
+
+void setParamsCallback(const leo_msgs::SetParamsRequest &req,
+                       leo_msgs::SetParamsResponse &res) {
+  // Static, so that the padding bytes compared by saveCached() are zeroed
+  static Parameters new_params;
+  new_params.load(req);
+
+  // The parameters are provided by the host, no need to fetch them
+  params_fetched = true;
+
+  switch (applyParameters(new_params)) {
+    case ParamsUpdate::UNCHANGED:
+      res.message = "Parameters unchanged";
+      break;
+    case ParamsUpdate::APPLIED:
+      res.message = "Parameters applied";
+      break;
+    case ParamsUpdate::RESTART:
+      res.message = "Parameters saved, restarting the board to apply them";
+      break;
+  }
+  res.success = true;
+}
+
+void setBaudRateCallback(const leo_msgs::SetBaudRateRequest &req,
+                         leo_msgs::SetBaudRateResponse &res) {
+  for (const uint32_t baud_rate : ROSSERIAL_BAUD_RATES) {
+    if (req.baud_rate == baud_rate) {
+      // The switch is done in loop() once this response has been sent
+      pending_baud_rate = baud_rate;
+      res.message =
+          "Switching baud rate, reconnect and call firmware/confirm_baud_rate";
+      res.success = true;
+      return;
+    }
+  }
+  res.message = "Unsupported baud rate";
+  res.success = false;
+}
+
+void triggerBlackBoxCallback(const std_srvs::TriggerRequest &req,
+                             std_srvs::TriggerResponse &res) {
+  if (black_box.trigger(BlackBoxTrigger::SERVICE)) {
+    res.message = "Black box triggered, the recording follows on "
+                  "firmware/black_box";
+    res.success = true;
+  } else {
+    res.message = "Black box already triggered";
+    res.success = false;
+  }
+}
+
+void confirmBaudRateCallback(const std_srvs::TriggerRequest &req,
+                             std_srvs::TriggerResponse &res) {
+  baud_rate_confirmed = true;
+  res.message = "Baud rate confirmed";
+  res.success = true;
+}
+
 struct WheelWrapper {
-  explicit WheelWrapper(diff_drive_lib::WheelController &wheel,
-                        std::string wheel_name)
-      : wheel_(wheel),
-        cmd_pwm_topic("firmware/wheel_" + wheel_name + "/cmd_pwm_duty"),
-        cmd_vel_topic("firmware/wheel_" + wheel_name + "/cmd_velocity"),
-        cmd_pwm_sub_(cmd_pwm_topic.c_str(), &WheelWrapper::cmdPWMDutyCallback,
-                     this),
-        cmd_vel_sub_(cmd_vel_topic.c_str(), &WheelWrapper::cmdVelCallback,
-                     this) {}
-
-  void initROS() {
+  explicit WheelWrapper(const char *cmd_pwm_topic, const char *cmd_vel_topic,
+                        const char *cmd_torque_topic)
+      : cmd_pwm_sub_(cmd_pwm_topic, &WheelWrapper::cmdPWMDutyCallback, this),
+        cmd_vel_sub_(cmd_vel_topic, &WheelWrapper::cmdVelCallback, this),
+        cmd_torque_sub_(cmd_torque_topic, &WheelWrapper::cmdTorqueCallback,
+                        this) {}
+
+  void initROS(diff_drive_lib::WheelController &wheel, MotorController &motor) {
+    wheel_ = &wheel;
+    motor_ = &motor;
     nh.subscribe(cmd_pwm_sub_);
     nh.subscribe(cmd_vel_sub_);
+    nh.subscribe(cmd_torque_sub_);
   }
 
   void cmdPWMDutyCallback(const std_msgs::Float32 &msg) {
-    wheel_.disable();
-    wheel_.motor.setPWMDutyCycle(msg.data);
+    commandReceived();
+    wheel_->disable();
+    wheel_->motor.setPWMDutyCycle(msg.data);
   }
 
   void cmdVelCallback(const std_msgs::Float32 &msg) {
-    wheel_.enable();
-    wheel_.setTargetVelocity(msg.data);
+    commandReceived();
+    wheel_->enable();
+    wheel_->setTargetVelocity(msg.data);
+  }
+
+  // The torque is held by the current loop of the motor, the duty cycle is
+  // bounded by the same limit as in the velocity mode
+  void cmdTorqueCallback(const std_msgs::Float32 &msg) {
+    commandReceived();
+    wheel_->disable();
+    motor_->setTargetCurrent(msg.data / params.wheel_torque_constant,
+                             params.wheel_pwm_duty_limit);
   }
 
  private:
-  diff_drive_lib::WheelController &wheel_;
-  std::string cmd_pwm_topic;
-  std::string cmd_vel_topic;
+  diff_drive_lib::WheelController *wheel_ = nullptr;
+  MotorController *motor_ = nullptr;
   ros::Subscriber<std_msgs::Float32, WheelWrapper> cmd_pwm_sub_;
   ros::Subscriber<std_msgs::Float32, WheelWrapper> cmd_vel_sub_;
+  ros::Subscriber<std_msgs::Float32, WheelWrapper> cmd_torque_sub_;
 };
 
-static WheelWrapper *wheel_FL_wrapper;
-static WheelWrapper *wheel_RL_wrapper;
-static WheelWrapper *wheel_FR_wrapper;
-static WheelWrapper *wheel_RR_wrapper;
+static WheelWrapper wheel_FL_wrapper(WHEEL_TOPIC("FL", "cmd_pwm_duty"),
+                                     WHEEL_TOPIC("FL", "cmd_velocity"),
+                                     WHEEL_TOPIC("FL", "cmd_torque"));
+static WheelWrapper wheel_RL_wrapper(WHEEL_TOPIC("RL", "cmd_pwm_duty"),
+                                     WHEEL_TOPIC("RL", "cmd_velocity"),
+                                     WHEEL_TOPIC("RL", "cmd_torque"));
+static WheelWrapper wheel_FR_wrapper(WHEEL_TOPIC("FR", "cmd_pwm_duty"),
+                                     WHEEL_TOPIC("FR", "cmd_velocity"),
+                                     WHEEL_TOPIC("FR", "cmd_torque"));
+static WheelWrapper wheel_RR_wrapper(WHEEL_TOPIC("RR", "cmd_pwm_duty"),
+                                     WHEEL_TOPIC("RR", "cmd_velocity"),
+                                     WHEEL_TOPIC("RR", "cmd_torque"));
 
 static ros::Subscriber<geometry_msgs::Twist> twist_sub("cmd_vel",
                                                        &cmdVelCallback);
@@ -143,18 +516,44 @@ static TriggerService board_type_srv("firmware/get_board_type",
                                      &getBoardTypeCallback);
 static TriggerService reset_board_srv("firmware/reset_board",
                                       &resetBoardCallback);
+static TriggerService confirm_baud_rate_srv("firmware/confirm_baud_rate",
+                                            &confirmBaudRateCallback);
+static ros::ServiceServer<leo_msgs::SetBaudRateRequest,
+                          leo_msgs::SetBaudRateResponse>
+    set_baud_rate_srv("firmware/set_baud_rate", &setBaudRateCallback);
+static ros::ServiceServer<leo_msgs::SetParamsRequest,
+                          leo_msgs::SetParamsResponse>
+    set_params_srv("firmware/set_params", &setParamsCallback);
+static TriggerService diagnostics_srv("firmware/get_diagnostics",
+                                      &getDiagnosticsCallback);
+static TriggerService black_box_srv("firmware/trigger_black_box",
+                                    &triggerBlackBoxCallback);
+#ifdef FIRMWARE_PROFILING
+static TriggerService profiling_srv("firmware/get_profiling",
+                                    &getProfilingCallback);
+#endif
 
 void initROS() {
   // Publishers
-  nh.advertise(battery_pub);
-  nh.advertise(battery_averaged_pub);
-  if (params.mecanum_wheels) {
-    nh.advertise(wheel_odom_mecanum_pub);
+  if (params.state_frame == 1) {
+    nh.advertise(state_pub);
+  } else if (params.state_frame == 2) {
+    nh.advertise(state_quantized_pub);
   } else {
-    nh.advertise(wheel_odom_pub);
+    nh.advertise(battery_pub);
+    nh.advertise(battery_averaged_pub);
+#ifndef FIRMWARE_DRIVE_DIFF
+    if (params.mecanumWheels()) nh.advertise(wheel_odom_mecanum_pub);
+#endif
+#ifndef FIRMWARE_DRIVE_MECANUM
+    if (!params.mecanumWheels()) nh.advertise(wheel_odom_pub);
+#endif
+    nh.advertise(wheel_states_pub);
   }
-  nh.advertise(wheel_states_pub);
   nh.advertise(imu_pub);
+  if (params.imu_batch_decimation > 0) nh.advertise(imu_batch_pub);
+  if (params.odom_fusion) nh.advertise(odom_fused_pub);
+  nh.advertise(black_box_pub);
 
   // Subscribers
   nh.subscribe(twist_sub);
@@ -164,92 +563,637 @@ void initROS() {
   nh.advertiseService(firmware_version_srv);
   nh.advertiseService(board_type_srv);
   nh.advertiseService(reset_board_srv);
+  nh.advertiseService(diagnostics_srv);
+  nh.advertiseService(set_baud_rate_srv);
+  nh.advertiseService(set_params_srv);
+  nh.advertiseService(confirm_baud_rate_srv);
+  nh.advertiseService(black_box_srv);
+#ifdef FIRMWARE_PROFILING
+  nh.advertiseService(profiling_srv);
+#endif
+
+  wheel_FL_wrapper.initROS(controller->wheel_FL, MotC);
+  wheel_RL_wrapper.initROS(controller->wheel_RL, MotD);
+  wheel_FR_wrapper.initROS(controller->wheel_FR, MotA);
+  wheel_RR_wrapper.initROS(controller->wheel_RR, MotB);
+}
 
-  wheel_FL_wrapper->initROS();
-  wheel_RL_wrapper->initROS();
-  wheel_FR_wrapper->initROS();
-  wheel_RR_wrapper->initROS();
+static void setUpdatePeriod(uint16_t period) {
+  HAL_TIM_Base_Stop_IT(&UPDATE_TIM);
+  update_period = period;
+  dividers = TaskDividers(period);
+  __HAL_TIM_SET_AUTORELOAD(&UPDATE_TIM, period * 1000 - 1);
+  __HAL_TIM_SET_COUNTER(&UPDATE_TIM, 0);
+  PROFILE_SET_UPDATE_BUDGET(period * (SystemCoreClock / 1000));
+  HAL_TIM_Base_Start_IT(&UPDATE_TIM);
+}
+
+static void setBaudRate(uint32_t baud_rate) {
+  HAL_UART_Abort(&ROSSERIAL_UART);
+  ROSSERIAL_UART.Init.BaudRate = baud_rate;
+  HAL_UART_Init(&ROSSERIAL_UART);
+  nh.initNode();
+  baud_rate_link_time = time();
+}
+
+// Applies the baud rate requested by the host and falls back to the default
+// one if the host does not keep up the connection at the new rate or the UART
+// reports an error
+static void updateBaudRate() {
+  if (uart_error) {
+    uart_error = false;
+    if (ROSSERIAL_UART.Init.BaudRate != ROSSERIAL_DEFAULT_BAUD_RATE) {
+      pending_baud_rate = 0;
+      baud_rate_confirmed = true;
+      setBaudRate(ROSSERIAL_DEFAULT_BAUD_RATE);
+    } else {
+      nh.initNode();
+    }
+  }
+
+  // Switch once the response to the request has left the buffers
+  if (pending_baud_rate != 0 && nh.getHardware()->txIdle()) {
+    setBaudRate(pending_baud_rate);
+    pending_baud_rate = 0;
+    baud_rate_confirmed = false;
+  }
+
+  if (ROSSERIAL_UART.Init.BaudRate == ROSSERIAL_DEFAULT_BAUD_RATE) return;
+
+  if (nh.connected() && baud_rate_confirmed) {
+    baud_rate_link_time = time();
+  } else if (time() - baud_rate_link_time > BAUD_RATE_FALLBACK_TIMEOUT) {
+    setBaudRate(ROSSERIAL_DEFAULT_BAUD_RATE);
+    baud_rate_confirmed = true;
+  }
 }
 
 void setup() {
+  last_reset_cause = reset_cause();
+  cycle_counter_init();
+
   nh.getHardware()->setUart(&ROSSERIAL_UART);
   nh.initNode();
 
-  // Wait for rosserial connection
-  while (!nh.connected()) {
-    nh.spinOnce();
+  // Start with the cached parameters if there are any, the ones from the ROS
+  // parameter server are fetched by loop() afterwards
+  params_fetched = !params.loadCached();
+  if (params_fetched) {
+    // Wait for rosserial connection
+    while (!nh.connected()) {
+      nh.spinOnce();
+    }
+
+    params.load(nh);
+    params.saveCached();
   }
 
-  params.load(nh);
-  if (params.mecanum_wheels) {
-    controller = new diff_drive_lib::MecanumController(ROBOT_CONFIG);
-  } else {
-    controller = new diff_drive_lib::DiffDriveController(ROBOT_CONFIG);
+  scaleToSubticks(params);
+
+  uint16_t period = DEFAULT_UPDATE_PERIOD;
+  if (params.control_frequency > 0 && 1000 % params.control_frequency == 0 &&
+      DEFAULT_UPDATE_PERIOD % (1000 / params.control_frequency) == 0) {
+    period = 1000 / params.control_frequency;
   }
 
-  wheel_FL_wrapper = new WheelWrapper(controller->wheel_FL, "FL");
-  wheel_RL_wrapper = new WheelWrapper(controller->wheel_RL, "RL");
-  wheel_FR_wrapper = new WheelWrapper(controller->wheel_FR, "FR");
-  wheel_RR_wrapper = new WheelWrapper(controller->wheel_RR, "RR");
+  // Keep the time span of the velocity estimation independent of the rate
+  diff_drive_lib::RobotConfiguration robot_config = ROBOT_CONFIG;
+  const size_t window_size = VELOCITY_WINDOW_PERIOD / period;
+  robot_config.wheel_FL_conf.velocity_rolling_window_size = window_size;
+  robot_config.wheel_RL_conf.velocity_rolling_window_size = window_size;
+  robot_config.wheel_FR_conf.velocity_rolling_window_size = window_size;
+  robot_config.wheel_RR_conf.velocity_rolling_window_size = window_size;
+
+#ifndef FIRMWARE_DRIVE_DIFF
+  if (params.mecanumWheels()) {
+    controller = new (&controller_storage)
+        diff_drive_lib::MecanumController(robot_config);
+  }
+#endif
+#ifndef FIRMWARE_DRIVE_MECANUM
+  if (!params.mecanumWheels()) {
+    controller = new (&controller_storage)
+        diff_drive_lib::DiffDriveController(robot_config);
+  }
+#endif
 
   initROS();
 
   imu_receiver.init();
 
+  imu_batch.stamp = imu_batch_stamp;
+  imu_batch.temperature = imu_batch_temperature;
+  imu_batch.gyro_x = imu_batch_gyro_x;
+  imu_batch.gyro_y = imu_batch_gyro_y;
+  imu_batch.gyro_z = imu_batch_gyro_z;
+  imu_batch.accel_x = imu_batch_accel_x;
+  imu_batch.accel_y = imu_batch_accel_y;
+  imu_batch.accel_z = imu_batch_accel_z;
+
+  black_box_chunk.time_offset = black_box_time_offset;
+  black_box_chunk.encoder_delta = black_box_encoder_delta;
+  black_box_chunk.pwm_duty = black_box_pwm_duty;
+  black_box_chunk.current = black_box_current;
+  black_box_chunk.gyro = black_box_gyro;
+  black_box_chunk.battery = black_box_battery;
+
   // Initialize Robot Controller
   controller->init(params);
+  motors.setCurrentLimit(params.wheel_current_limit);
+
+  setUpdatePeriod(period);
 
   configured = true;
+
+  watchdog_init(WATCHDOG_TIMEOUT);
+}
+
+// Fetches the parameters from the ROS parameter server, one per call so that
+// loop() keeps publishing in between, and once all of them have arrived
+// applies them if they differ from the cached ones the firmware has started
+// with. A parameter which does not arrive is requested again, and if it never
+// does, the fetch is abandoned, so that an incomplete set is never applied.
+static void fetchParameters() {
+  // Static, so that the padding bytes compared by saveCached() are zeroed
+  static Parameters fetched_params;
+  static uint8_t index = 0;
+  static uint8_t attempts = 0;
+  if (index < Parameters::COUNT) {
+    if (fetched_params.load(nh, index, PARAMS_FETCH_TIMEOUT)) {
+      ++index;
+      attempts = 0;
+    } else if (++attempts == PARAMS_FETCH_ATTEMPTS) {
+      params_fetched = true;
+      nh.logwarn("Failed to fetch the parameters, keeping the cached ones");
+    }
+    return;
+  }
+
+  params_fetched = true;
+  applyParameters(fetched_params);
+}
+
+static void reportResetCause() {
+  static char message[48];
+  std::snprintf(message, sizeof(message), "Started after %s reset",
+                last_reset_cause);
+  nh.loginfo(message);
+}
+
+// Stops the motors and resets the board once the response to the reset request
+// has had time to be sent
+static void restart() {
+  configured = false;
+  motors.stop();
+  motors.sleep();
+
+  const uint32_t start = time();
+  while (time() - start < RESET_DELAY) {
+    nh.spinOnce();
+    watchdog_feed();
+  }
+  reset();
+}
+
+// Enters the idle mode once the commands stop and, while in it, sleeps until
+// the next interrupt. SysTick wakes the CPU at least every millisecond.
+static void updateIdle() {
+  if (!idle && time() - last_command_time >
+                   static_cast<uint32_t>(params.robot_input_timeout)) {
+    motors.sleep();
+    idle = true;
+  }
+
+  if (idle) __WFI();
+}
+
+// Handles the frames which arrived while loop() was busy publishing, so that
+// incoming commands do not wait for the whole publishing pass
+static void spinIfReceived() {
+  if (nh.getHardware()->dataReceived()) {
+    PROFILE_SCOPE(PROFILE_SPIN);
+    nh.spinOnce();
+  }
+}
+
+// Converts a micros() time of a recent event to the ROS time. nh.now() only
+// has the resolution of the millisecond tick, so the offset of the event is
+// taken from the start of the current tick.
+static ros::Time toRosTime(uint32_t time_us) {
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  ros::Time stamp = nh.now();
+  const uint32_t tick_us = time() * 1000;
+  __set_PRIMASK(primask);
+
+  const int32_t offset_us = static_cast<int32_t>(time_us - tick_us);
+  int32_t sec = static_cast<int32_t>(stamp.sec);
+  int32_t nsec = static_cast<int32_t>(stamp.nsec) + offset_us % 1000000 * 1000;
+  sec += offset_us / 1000000;
+  if (nsec < 0) {
+    nsec += 1000000000;
+    --sec;
+  } else if (nsec >= 1000000000) {
+    nsec -= 1000000000;
+    ++sec;
+  }
+  stamp.sec = static_cast<uint32_t>(sec);
+  stamp.nsec = static_cast<uint32_t>(nsec);
+  return stamp;
+}
+
+// Publishes the frozen black box recording one chunk at a time, after all the
+// other messages, and re-arms the black box once the whole recording is sent
+static void publishBlackBox() {
+  static uint16_t next = 0;
+  static uint32_t last_chunk_time = 0;
+
+  if (!black_box.frozen() ||
+      time() - last_chunk_time < BLACK_BOX_CHUNK_PERIOD) {
+    return;
+  }
+  last_chunk_time = time();
+
+  spinIfReceived();
+  PROFILE_SCOPE(PROFILE_PUB_BLACK_BOX);
+
+  // The records are timed relative to the one taken at the trigger
+  const uint16_t total = black_box.size();
+  const uint16_t trigger_index = black_box.triggerIndex();
+  const uint32_t trigger_time = black_box.at(trigger_index).time;
+  if (next == 0) black_box_chunk.stamp = toRosTime(trigger_time);
+
+  const uint16_t remaining = total - next;
+  const uint16_t count =
+      remaining < BLACK_BOX_CHUNK_SIZE ? remaining : BLACK_BOX_CHUNK_SIZE;
+  for (uint16_t i = 0; i < count; ++i) {
+    const BlackBoxRecord &record = black_box.at(next + i);
+    black_box_time_offset[i] = static_cast<int32_t>(record.time - trigger_time);
+    for (uint8_t w = 0; w < 4; ++w) {
+      black_box_encoder_delta[i * 4 + w] = record.encoder[w];
+      black_box_pwm_duty[i * 4 + w] = record.pwm_duty[w];
+      black_box_current[i * 4 + w] = record.current[w];
+    }
+    for (uint8_t a = 0; a < 3; ++a) black_box_gyro[i * 3 + a] = record.gyro[a];
+    black_box_battery[i] = record.battery;
+  }
+
+  black_box_chunk.trigger = static_cast<uint8_t>(black_box.cause());
+  black_box_chunk.trigger_index = trigger_index;
+  black_box_chunk.index = next;
+  black_box_chunk.total = total;
+  black_box_chunk.time_offset_length = black_box_chunk.battery_length = count;
+  black_box_chunk.encoder_delta_length = black_box_chunk.pwm_duty_length =
+      black_box_chunk.current_length = count * 4;
+  black_box_chunk.gyro_length = count * 3;
+  black_box_pub.publish(&black_box_chunk);
+
+  next += count;
+  if (next == total) {
+    next = 0;
+    black_box.rearm();
+  }
 }
 
 void loop() {
-  nh.spinOnce();
+  {
+    PROFILE_SCOPE(PROFILE_SPIN);
+    nh.spinOnce();
+  }
+
+  if (update_progress.exchange(false)) watchdog_feed();
+
+  updateBaudRate();
+
+  if (reset_request) restart();
+
+  updateIdle();
 
   if (!nh.connected()) return;
 
-  if (publish_battery) {
+  static bool reset_cause_reported = false;
+  if (!reset_cause_reported) {
+    reset_cause_reported = true;
+    reportResetCause();
+  }
+
+  if (!params_fetched) fetchParameters();
+
+  BatterySample battery_sample;
+  while (battery_queue.pop(battery_sample)) {
+    spinIfReceived();
+    PROFILE_SCOPE(PROFILE_PUB_BATTERY);
+    battery.data = battery_sample.voltage;
+    battery_averaged.data = battery_sample.voltage_averaged;
     battery_pub.publish(&battery);
     battery_averaged_pub.publish(&battery_averaged);
-    publish_battery = false;
   }
 
-  if (publish_wheel_odom) {
-    if (params.mecanum_wheels) {
-      wheel_odom_mecanum_pub.publish(&wheel_odom_mecanum);
-    } else {
-      wheel_odom_pub.publish(&wheel_odom);
-    }
-    publish_wheel_odom = false;
+#ifndef FIRMWARE_DRIVE_MECANUM
+  while (wheel_odom_queue.pop(wheel_odom)) {
+    spinIfReceived();
+    PROFILE_SCOPE(PROFILE_PUB_ODOM);
+    wheel_odom_pub.publish(&wheel_odom);
   }
+#endif
 
-  if (publish_wheel_states) {
+#ifndef FIRMWARE_DRIVE_DIFF
+  while (wheel_odom_mecanum_queue.pop(wheel_odom_mecanum)) {
+    spinIfReceived();
+    PROFILE_SCOPE(PROFILE_PUB_ODOM);
+    wheel_odom_mecanum_pub.publish(&wheel_odom_mecanum);
+  }
+#endif
+
+  while (wheel_states_queue.pop(wheel_states)) {
+    spinIfReceived();
+    PROFILE_SCOPE(PROFILE_PUB_WHEEL_STATES);
     wheel_states_pub.publish(&wheel_states);
-    publish_wheel_states = false;
   }
 
-  if (publish_imu) {
+  while (imu_queue.pop(imu)) {
+    spinIfReceived();
+    PROFILE_SCOPE(PROFILE_PUB_IMU);
     imu_pub.publish(&imu);
-    publish_imu = false;
   }
+
+  while (odom_fused_queue.pop(odom_fused)) {
+    spinIfReceived();
+    PROFILE_SCOPE(PROFILE_PUB_ODOM);
+    odom_fused_pub.publish(&odom_fused);
+  }
+
+  while (state_queue.pop(state)) {
+    spinIfReceived();
+    PROFILE_SCOPE(PROFILE_PUB_STATE);
+    state_pub.publish(&state);
+  }
+
+  while (state_quantized_queue.pop(state_quantized)) {
+    spinIfReceived();
+    PROFILE_SCOPE(PROFILE_PUB_STATE);
+    state_quantized_pub.publish(&state_quantized);
+  }
+
+  ImuBatchEntry entry;
+  while (imu_batch_queue.pop(entry)) {
+    imu_batch_stamp[imu_batch_size] = entry.stamp;
+    imu_batch_temperature[imu_batch_size] = entry.sample.temp;
+    imu_batch_accel_x[imu_batch_size] = entry.sample.ax;
+    imu_batch_accel_y[imu_batch_size] = entry.sample.ay;
+    imu_batch_accel_z[imu_batch_size] = entry.sample.az;
+    imu_batch_gyro_x[imu_batch_size] = entry.sample.gx;
+    imu_batch_gyro_y[imu_batch_size] = entry.sample.gy;
+    imu_batch_gyro_z[imu_batch_size] = entry.sample.gz;
+
+    if (++imu_batch_size < IMU_BATCH_SIZE) continue;
+
+    spinIfReceived();
+    PROFILE_SCOPE(PROFILE_PUB_IMU_BATCH);
+    imu_batch.stamp_length = imu_batch.temperature_length = imu_batch_size;
+    imu_batch.gyro_x_length = imu_batch.gyro_y_length =
+        imu_batch.gyro_z_length = imu_batch_size;
+    imu_batch.accel_x_length = imu_batch.accel_y_length =
+        imu_batch.accel_z_length = imu_batch_size;
+    imu_batch_pub.publish(&imu_batch);
+    imu_batch_size = 0;
+  }
+
+  publishBlackBox();
 }
 
-void update() {
+static int16_t quantize(float value, float scale) {
+  const float scaled = value * scale;
+  if (scaled >= static_cast<float>(INT16_MAX)) return INT16_MAX;
+  if (scaled <= static_cast<float>(INT16_MIN)) return INT16_MIN;
+  return static_cast<int16_t>(scaled >= 0.0F ? scaled + 0.5F : scaled - 0.5F);
+}
+
+static void quantizeState(const leo_msgs::FirmwareState &in,
+                          leo_msgs::FirmwareStateQuantized &out) {
+  out.stamp = in.stamp;
+  out.battery = quantize(in.battery, STATE_BATTERY_SCALE);
+  out.battery_averaged = quantize(in.battery_averaged, STATE_BATTERY_SCALE);
+  out.velocity_lin_x = quantize(in.velocity_lin_x, STATE_VELOCITY_SCALE);
+  out.velocity_lin_y = quantize(in.velocity_lin_y, STATE_VELOCITY_SCALE);
+  out.velocity_ang = quantize(in.velocity_ang, STATE_VELOCITY_SCALE);
+  out.pose_x = in.pose_x;
+  out.pose_y = in.pose_y;
+  out.pose_yaw = in.pose_yaw;
+  for (size_t i = 0; i < 4; i++) {
+    out.wheel_position[i] = in.wheel_position[i];
+    out.wheel_velocity[i] =
+        quantize(in.wheel_velocity[i], STATE_VELOCITY_SCALE);
+    out.wheel_torque[i] = quantize(in.wheel_torque[i], STATE_TORQUE_SCALE);
+    out.wheel_pwm_duty_cycle[i] =
+        quantize(in.wheel_pwm_duty_cycle[i], STATE_PWM_SCALE);
+  }
+  out.imu_temperature = quantize(in.imu_temperature, STATE_TEMPERATURE_SCALE);
+  out.imu_gyro_x = quantize(in.imu_gyro_x, STATE_GYRO_SCALE);
+  out.imu_gyro_y = quantize(in.imu_gyro_y, STATE_GYRO_SCALE);
+  out.imu_gyro_z = quantize(in.imu_gyro_z, STATE_GYRO_SCALE);
+  out.imu_accel_x = quantize(in.imu_accel_x, STATE_ACCEL_SCALE);
+  out.imu_accel_y = quantize(in.imu_accel_y, STATE_ACCEL_SCALE);
+  out.imu_accel_z = quantize(in.imu_accel_z, STATE_ACCEL_SCALE);
+}
+
+// Averages the samples picked up from the IMU FIFO in groups of
+// imu_batch_decimation and queues them for the batch message
+static void fillImuBatch() {
+  static ImuSample sum = {};
+  static int sum_count = 0;
+  static uint32_t group_start = 0;
+
+  const uint8_t count = imu_receiver.sample_count;
+  for (uint8_t i = 0; i < count; ++i) {
+    const ImuSample &sample = imu_receiver.samples[i];
+    if (sum_count == 0) group_start = sample.time;
+    sum.temp += sample.temp;
+    sum.ax += sample.ax;
+    sum.ay += sample.ay;
+    sum.az += sample.az;
+    sum.gx += sample.gx;
+    sum.gy += sample.gy;
+    sum.gz += sample.gz;
+    if (++sum_count < params.imu_batch_decimation) continue;
+
+    // The average is stamped with the middle of its group
+    ImuBatchEntry entry;
+    entry.stamp = toRosTime(group_start + (sample.time - group_start) / 2);
+
+    const float scale = 1.0F / static_cast<float>(sum_count);
+    entry.sample.temp = sum.temp * scale;
+    entry.sample.ax = sum.ax * scale;
+    entry.sample.ay = sum.ay * scale;
+    entry.sample.az = sum.az * scale;
+    entry.sample.gx = sum.gx * scale;
+    entry.sample.gy = sum.gy * scale;
+    entry.sample.gz = sum.gz * scale;
+    imu_batch_queue.push(entry);
+
+    sum = {};
+    sum_count = 0;
+  }
+}
+
+static int16_t saturate(int32_t value) {
+  if (value > INT16_MAX) return INT16_MAX;
+  if (value < INT16_MIN) return INT16_MIN;
+  return static_cast<int16_t>(value);
+}
+
+// Records the state of the drive on the current update() call in the black box
+// and triggers it if any of the motors draws too much current. The gyroscope
+// data comes from the IMU samples picked up by the previous call.
+static void recordBlackBox(uint32_t latch_time, float battery_new) {
+  PROFILE_SCOPE(PROFILE_BLACK_BOX);
+  static int32_t last_encoder[4] = {};
+
+  BlackBoxRecord record;
+  record.time = latch_time;
+  bool overcurrent = false;
+  for (uint8_t i = 0; i < 4; ++i) {
+    MotorController &motor = *wheel_motors[i];
+    const int32_t encoder = motor.getEncoderCnt();
+    // The count wraps around, the difference is taken modulo 2^32
+    const uint32_t change =
+        static_cast<uint32_t>(encoder) - static_cast<uint32_t>(last_encoder[i]);
+    record.encoder[i] = saturate(static_cast<int32_t>(change));
+    last_encoder[i] = encoder;
+    record.pwm_duty[i] = quantize(motor.getPWMDutyCycle(), STATE_PWM_SCALE);
+    const float current = motor.getWindingCurrent();
+    record.current[i] =
+        static_cast<uint16_t>(quantize(current, BLACK_BOX_CURRENT_SCALE));
+    if (current > BLACK_BOX_OVERCURRENT) overcurrent = true;
+  }
+  record.gyro[0] = quantize(imu_receiver.gx, BLACK_BOX_GYRO_SCALE);
+  record.gyro[1] = quantize(imu_receiver.gy, BLACK_BOX_GYRO_SCALE);
+  record.gyro[2] = quantize(imu_receiver.gz, BLACK_BOX_GYRO_SCALE);
+  record.battery =
+      static_cast<uint16_t>(quantize(battery_new, STATE_BATTERY_SCALE));
+
+  if (overcurrent) black_box.trigger(BlackBoxTrigger::OVERCURRENT);
+  black_box.record(record);
+}
+
+// Queues the fused state frame if it is due on the current update() call
+static void queueStateFrame(uint32_t cnt, const ros::Time &stamp,
+                            float battery_new, float battery_avg) {
+  if (cnt % dividers.state_pub == 0) {
+    PROFILE_SCOPE(PROFILE_STATE);
+    auto dd_wheel_states = controller->getWheelStates();
+    auto dd_odom = controller->getOdom();
+
+    leo_msgs::FirmwareState frame;
+    frame.stamp = stamp;
+    frame.battery = battery_new;
+    frame.battery_averaged = battery_avg;
+    frame.velocity_lin_x = dd_odom.velocity_lin_x;
+    frame.velocity_lin_y = dd_odom.velocity_lin_y;
+    frame.velocity_ang = dd_odom.velocity_ang;
+    frame.pose_x = dd_odom.pose_x;
+    frame.pose_y = dd_odom.pose_y;
+    frame.pose_yaw = dd_odom.pose_yaw;
+    for (size_t i = 0; i < 4; i++) {
+      frame.wheel_position[i] = dd_wheel_states.position[i];
+      frame.wheel_velocity[i] = dd_wheel_states.velocity[i];
+      frame.wheel_torque[i] = dd_wheel_states.torque[i];
+      frame.wheel_pwm_duty_cycle[i] = dd_wheel_states.pwm_duty_cycle[i];
+    }
+    frame.imu_temperature = imu_receiver.temp;
+    frame.imu_gyro_x = imu_receiver.gx;
+    frame.imu_gyro_y = imu_receiver.gy;
+    frame.imu_gyro_z = imu_receiver.gz;
+    frame.imu_accel_x = imu_receiver.ax;
+    frame.imu_accel_y = imu_receiver.ay;
+    frame.imu_accel_z = imu_receiver.az;
+
+    if (params.state_frame == 2) {
+      leo_msgs::FirmwareStateQuantized frame_quantized;
+      quantizeState(frame, frame_quantized);
+      state_quantized_queue.push(frame_quantized);
+    } else {
+      state_queue.push(frame);
+    }
+  }
+}
+
+// Queues the battery, wheel states and wheel odometry messages that are due
+// on the current update() call. The wheel data is stamped with the time at
+// which the encoders were latched.
+static void queueSeparateTopics(uint32_t cnt, const ros::Time &stamp,
+                                float battery_new, float battery_avg) {
+  if (cnt % dividers.battery_pub == 0) {
+    battery_queue.push({battery_new, battery_avg});
+  }
+
+  if (cnt % dividers.joints_pub == 0) {
+    PROFILE_SCOPE(PROFILE_WHEEL_STATES);
+    auto dd_wheel_states = controller->getWheelStates();
+
+    leo_msgs::WheelStates states;
+    states.stamp = stamp;
+    for (size_t i = 0; i < 4; i++) {
+      states.position[i] = dd_wheel_states.position[i];
+      states.velocity[i] = dd_wheel_states.velocity[i];
+      states.torque[i] = dd_wheel_states.torque[i];
+      states.pwm_duty_cycle[i] = dd_wheel_states.pwm_duty_cycle[i];
+    }
+
+    wheel_states_queue.push(states);
+  }
+
+  if (cnt % dividers.odom_pub == 0) {
+    PROFILE_SCOPE(PROFILE_ODOM);
+    auto dd_odom = controller->getOdom();
+
+#ifndef FIRMWARE_DRIVE_DIFF
+    if (params.mecanumWheels()) {
+      leo_msgs::WheelOdomMecanum odom;
+      odom.stamp = stamp;
+      odom.velocity_lin_x = dd_odom.velocity_lin_x;
+      odom.velocity_lin_y = dd_odom.velocity_lin_y;
+      odom.velocity_ang = dd_odom.velocity_ang;
+      odom.pose_x = dd_odom.pose_x;
+      odom.pose_y = dd_odom.pose_y;
+      odom.pose_yaw = dd_odom.pose_yaw;
+      wheel_odom_mecanum_queue.push(odom);
+    }
+#endif
+#ifndef FIRMWARE_DRIVE_MECANUM
+    if (!params.mecanumWheels()) {
+      leo_msgs::WheelOdom odom;
+      odom.stamp = stamp;
+      odom.velocity_lin = dd_odom.velocity_lin_x;
+      odom.velocity_ang = dd_odom.velocity_ang;
+      odom.pose_x = dd_odom.pose_x;
+      odom.pose_y = dd_odom.pose_y;
+      odom.pose_yaw = dd_odom.pose_yaw;
+      wheel_odom_queue.push(odom);
+    }
+#endif
+  }
+}
+
+static void updateTick() {
+  PROFILE_SCOPE(PROFILE_UPDATE);
+
   static uint32_t cnt = 0;
   ++cnt;
 
-  static float battery_sum = 0.0F;
+  static float battery_new = 0.0F;
   static float battery_avg = 0.0F;
-  float battery_new = static_cast<float>(BATTERY_ADC) * BATTERY_ADC_TO_VOLTAGE;
-  battery_sum += battery_new;
-  battery_sum -= battery_buffer_.push_back(battery_new);
-  battery_avg =
-      battery_sum / static_cast<float>(std::min(BATTERY_BUFFER_SIZE, cnt));
+  if (cnt % dividers.battery_filter == 0) {
+    PROFILE_SCOPE(PROFILE_BATTERY);
+    battery_new = static_cast<float>(BATTERY_ADC) * BATTERY_ADC_TO_VOLTAGE;
+    battery_avg = battery_filter.update(battery_new);
+  }
 
   if (battery_avg < params.battery_min_voltage) {
-    if (cnt % 10 == 0) gpio_toggle(LED);
+    if (cnt % dividers.led_low_battery == 0) gpio_toggle(LED);
   } else {
     if (!nh.connected()) {
-      if (cnt % 50 == 0) gpio_toggle(LED);
+      if (cnt % dividers.led_disconnected == 0) gpio_toggle(LED);
     } else {
       gpio_reset(LED);
     }
@@ -257,71 +1201,156 @@ void update() {
 
   if (!configured) return;
 
-  controller->update(UPDATE_PERIOD);
+  static Parameters new_params;
+  if (params_mailbox.take(new_params)) {
+    params = new_params;
+    controller->init(params);
+    motors.setCurrentLimit(params.wheel_current_limit);
+  }
 
-  if (!nh.connected()) return;
+  SpeedCommand cmd;
+  if (cmd_vel_mailbox.take(cmd)) {
+    controller->setSpeed(cmd.linear_x, cmd.linear_y, cmd.angular_z);
+    cmd_vel_latency.add(cycles() - cmd.received);
+  }
 
-  if (reset_request) {
-    delay(1000);
-    reset();
+  uint32_t latch_time;
+  {
+    PROFILE_SCOPE(PROFILE_CONTROLLER);
+    latch_time = micros();
+    motors.latch();
+    controller->update(update_period);
+    motors.commit();
   }
 
-  if (cnt % BATTERY_PUB_PERIOD == 0 && !publish_battery) {
-    battery.data = battery_new;
-    battery_averaged.data = battery_avg;
+  recordBlackBox(latch_time, battery_new);
+
+  if (!nh.connected()) return;
 
-    publish_battery = true;
+  const ros::Time latch_stamp = toRosTime(latch_time);
+  if (params.state_frame != 0) {
+    queueStateFrame(cnt, latch_stamp, battery_new, battery_avg);
+  } else {
+    queueSeparateTopics(cnt, latch_stamp, battery_new, battery_avg);
   }
 
-  if (cnt % JOINTS_PUB_PERIOD == 0 && !publish_wheel_states) {
-    auto dd_wheel_states = controller->getWheelStates();
+  if (params.odom_fusion && odom_fusion_reset_request.exchange(false)) {
+    odom_fusion.reset();
+  }
 
-    wheel_states.stamp = nh.now();
-    for (size_t i = 0; i < 4; i++) {
-      wheel_states.position[i] = dd_wheel_states.position[i];
-      wheel_states.velocity[i] = dd_wheel_states.velocity[i];
-      wheel_states.torque[i] = dd_wheel_states.torque[i];
-      wheel_states.pwm_duty_cycle[i] = dd_wheel_states.pwm_duty_cycle[i];
+  if (cnt % dividers.imu_pub == 0) {
+    PROFILE_SCOPE(PROFILE_IMU);
+    if (imu_receiver.update()) {
+      leo_msgs::Imu sample;
+      sample.stamp = toRosTime(imu_receiver.time);
+      sample.temperature = imu_receiver.temp;
+      sample.accel_x = imu_receiver.ax;
+      sample.accel_y = imu_receiver.ay;
+      sample.accel_z = imu_receiver.az;
+      sample.gyro_x = imu_receiver.gx;
+      sample.gyro_y = imu_receiver.gy;
+      sample.gyro_z = imu_receiver.gz;
+      imu_queue.push(sample);
+
+      if (params.imu_batch_decimation > 0) fillImuBatch();
+
+      if (params.odom_fusion) {
+        odom_fusion.update(imu_receiver.samples, imu_receiver.sample_count,
+                           controller->getOdom());
+      }
     }
+  }
 
-    publish_wheel_states = true;
+  if (params.odom_fusion) {
+    odom_fusion.updateWheels(controller->getOdom(), latch_time);
   }
 
-  if (cnt % ODOM_PUB_PERIOD == 0 && !publish_wheel_odom) {
-    auto dd_odom = controller->getOdom();
+  if (params.odom_fusion && cnt % dividers.odom_pub == 0) {
+    leo_msgs::WheelOdomMecanum odom;
+    odom.stamp = latch_stamp;
+    odom.velocity_lin_x = odom_fusion.velocity_lin_x;
+    odom.velocity_lin_y = odom_fusion.velocity_lin_y;
+    odom.velocity_ang = odom_fusion.velocity_ang;
+    odom.pose_x = odom_fusion.pose_x;
+    odom.pose_y = odom_fusion.pose_y;
+    odom.pose_yaw = odom_fusion.pose_yaw;
+    odom_fused_queue.push(odom);
+  }
+}
 
-    if (params.mecanum_wheels) {
-      wheel_odom_mecanum.stamp = nh.now();
-      wheel_odom_mecanum.velocity_lin_x = dd_odom.velocity_lin_x;
-      wheel_odom_mecanum.velocity_lin_y = dd_odom.velocity_lin_y;
-      wheel_odom_mecanum.velocity_ang = dd_odom.velocity_ang;
-      wheel_odom_mecanum.pose_x = dd_odom.pose_x;
-      wheel_odom_mecanum.pose_y = dd_odom.pose_y;
-      wheel_odom_mecanum.pose_yaw = dd_odom.pose_yaw;
-    } else {
-      wheel_odom.stamp = nh.now();
-      wheel_odom.velocity_lin = dd_odom.velocity_lin_x;
-      wheel_odom.velocity_ang = dd_odom.velocity_ang;
-      wheel_odom.pose_x = dd_odom.pose_x;
-      wheel_odom.pose_y = dd_odom.pose_y;
-      wheel_odom.pose_yaw = dd_odom.pose_yaw;
-    }
-    publish_wheel_odom = true;
+void update() {
+  // The update timer counts microseconds from its update event
+  if (__HAL_TIM_GET_COUNTER(&UPDATE_TIM) > UPDATE_LATENESS_LIMIT) {
+    late_ticks = late_ticks + 1;
   }
 
-  if (cnt % IMU_PUB_PERIOD == 0 && !publish_imu) {
-    imu_receiver.update();
+  updateTick();
+
+  // The next update event has already occurred
+  if (__HAL_TIM_GET_FLAG(&UPDATE_TIM, TIM_FLAG_UPDATE)) {
+    overrun_ticks = overrun_ticks + 1;
+    motors.stop();
+  }
+
+  update_progress = true;
+}
+
+void sampleEncoders() {
+  MotA.sampleEncoder();
+  MotB.sampleEncoder();
+  MotC.sampleEncoder();
+  MotD.sampleEncoder();
+}
+
+void encoderOverflowCallback(TIM_TypeDef *tim) {
+  motors.encoderOverflowCallback(tim);
+}
 
-    imu.stamp = nh.now();
-    imu.temperature = imu_receiver.temp;
-    imu.accel_x = imu_receiver.ax;
-    imu.accel_y = imu_receiver.ay;
-    imu.accel_z = imu_receiver.az;
-    imu.gyro_x = imu_receiver.gx;
-    imu.gyro_y = imu_receiver.gy;
-    imu.gyro_z = imu_receiver.gz;
+void rosserialIdleCallback() {
+  nh.getHardware()->IdleCallback();
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+  if (GPIO_Pin == IMU_INT_2_Pin) {
+    imu_receiver.dataReadyCallback(micros());
+  } else {
+    motors.faultCallback(GPIO_Pin);
+    black_box.trigger(BlackBoxTrigger::FAULT);
+  }
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+  if (hi2c == &IMU_I2C) {
+    imu_receiver.readCompleteCallback();
+  }
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+  if (hi2c == &IMU_I2C) {
+    imu_receiver.readErrorCallback();
+  }
+}
+
+static void averageAdcSamples(const volatile uint16_t *samples) {
+  for (uint8_t ch = 0; ch < ADC_CHANNELS; ++ch) {
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < ADC_OVERSAMPLING; ++i)
+      sum += samples[i * ADC_CHANNELS + ch];
+    adc_buff[ch] = (sum + ADC_OVERSAMPLING / 2) / ADC_OVERSAMPLING;
+  }
+}
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc) {
+  if (hadc == &MEASUREMENTS_ADC) {
+    averageAdcSamples(&adc_dma_buff[0]);
+    motors.updateCurrentLoop();
+  }
+}
 
-    publish_imu = true;
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc) {
+  if (hadc == &MEASUREMENTS_ADC) {
+    averageAdcSamples(&adc_dma_buff[ADC_DMA_BUFFER_SIZE / 2]);
+    motors.updateCurrentLoop();
   }
 }
 
@@ -333,6 +1362,7 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
 
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
   if (huart == &ROSSERIAL_UART) {
-    nh.initNode();
+    // Reinitializing the UART here could break into spinOnce() in loop()
+    uart_error = true;
   }
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "firmware/motor_bank.hpp"
+
+MotorBank::MotorBank(MotorController *const (&motors)[MOTOR_COUNT],
+                     TIM_TypeDef *const (&pwm_timers)[MAX_PWM_TIMERS]) {
+  for (uint8_t i = 0; i < MAX_PWM_TIMERS; ++i) pwm_timers_[i] = pwm_timers[i];
+
+  for (uint8_t i = 0; i < MOTOR_COUNT; ++i) {
+    motors_[i] = motors[i];
+
+    GPIO_TypeDef *port = motors[i]->config_.phase.port;
+    uint8_t idx = 0;
+    while (idx < phase_port_count_ && phase_ports_[idx] != port) ++idx;
+    if (idx == phase_port_count_) phase_ports_[phase_port_count_++] = port;
+    phase_port_index_[i] = idx;
+  }
+}
+
+void MotorBank::encoderOverflowCallback(TIM_TypeDef *tim) {
+  for (MotorController *motor : motors_) {
+    if (motor->config_.enc_tim == tim) motor->encoderOverflowCallback();
+  }
+}
+
+void MotorBank::faultCallback(uint16_t pin) {
+  for (MotorController *motor : motors_) {
+    if (motor->config_.fault.pin == pin) motor->faultCallback();
+  }
+}
+
+void MotorBank::sleep() {
+  for (MotorController *motor : motors_) motor->sleep();
+}
+
+void MotorBank::wake() {
+  for (MotorController *motor : motors_) motor->wake();
+}
+
+void MotorBank::stop() {
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  for (MotorController *motor : motors_) {
+    // Keeps the current loop from restoring the output before the next commit
+    motor->committed_ccr_value_ = 0;
+    *motor->config_.pwm_ccr = 0;
+  }
+  __set_PRIMASK(primask);
+}
+
+void MotorBank::setCurrentLimit(float limit) {
+  for (MotorController *motor : motors_) motor->setCurrentLimit(limit);
+}
+
+void MotorBank::updateCurrentLoop() {
+  for (MotorController *motor : motors_) motor->updateCurrentLoop();
+}
+
+void MotorBank::latch() {
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const uint32_t now = cycles();
+  for (MotorController *motor : motors_) motor->latchEncoderCnt(now);
+  __set_PRIMASK(primask);
+}
+
+void MotorBank::commit() {
+  // The CCR registers are preloaded, block the update events while writing
+  // them, so that the new values of each timer take effect together. The
+  // fault interrupts and the current loop are held off, so that they cannot
+  // be overwritten.
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // The PHASE pins change immediately, while the new CCR values only at the
+  // next PWM period. A reversal is therefore held with the output off until
+  // the next commit, so that the old duty cycle is never driven the new way.
+  uint32_t bsrr[MOTOR_COUNT] = {};
+  for (uint8_t i = 0; i < MOTOR_COUNT; ++i) {
+    MotorController &motor = *motors_[i];
+    if (motor.phase_ == motor.output_phase_) {
+      motor.reversal_hold_ = false;
+    } else if (motor.reversal_hold_) {
+      motor.output_phase_ = motor.phase_;
+      motor.reversal_hold_ = false;
+    } else {
+      motor.reversal_hold_ = true;
+    }
+
+    // Set or reset all the PHASE pins with a single write per port
+    const uint32_t pin = motor.config_.phase.pin;
+    bsrr[phase_port_index_[i]] |= motor.output_phase_ ? pin : pin << 16;
+  }
+  for (uint8_t i = 0; i < phase_port_count_; ++i) {
+    phase_ports_[i]->BSRR = bsrr[i];
+  }
+
+  for (TIM_TypeDef *tim : pwm_timers_) tim->CR1 |= TIM_CR1_UDIS;
+  for (MotorController *motor : motors_) {
+    if (motor->fault_ && gpio_read(motor->config_.fault)) motor->fault_ = false;
+    motor->committed_ccr_value_ = motor->pwm_ccr_value_;
+    *motor->config_.pwm_ccr = motor->fault_ ? 0 : motor->limitedCcrValue();
+  }
+  for (TIM_TypeDef *tim : pwm_timers_) tim->CR1 &= ~TIM_CR1_UDIS;
+  __set_PRIMASK(primask);
+}
@@ -10,25 +10,71 @@ inline float clamp(const float value, const float limit) {
     return value;
 }
 
+static constexpr float PWM_DUTY_TO_CCR = static_cast<float>(PWM_RANGE) / 100.0F;
+
+MotorController::MotorController(const MotorConfiguration &config)
+    : config_(config),
+      ticks_wrap_(IS_TIM_32B_COUNTER_INSTANCE(config.enc_tim) ? 0 : 1 << 16) {}
+
 void MotorController::init() {
-  gpio_set(config_.nsleep);  // Wake up the driver
-  gpio_set(config_.mode);    // Turn on Slow-decay mode
+  // Wake up the driver, unless it has been put to sleep
+  if (!asleep_) gpio_set(config_.nsleep);
+  gpio_set(config_.mode);  // Turn on Slow-decay mode
+}
+
+// The flag is changed before the pin, so that an init() call in between
+// leaves the pin in the new state
+void MotorController::sleep() {
+  asleep_ = true;
+  gpio_reset(config_.nsleep);
+}
+
+void MotorController::wake() {
+  asleep_ = false;
+  gpio_set(config_.nsleep);
 }
 
 void MotorController::setPWMDutyCycle(float pwm_duty) {
+  current_mode_ = false;
+  setRequestedDuty(pwm_duty);
+}
+
+void MotorController::setTargetCurrent(float current, float pwm_duty_limit) {
+  float target = clamp(current, CURRENT_SENSE_RANGE);
+  float pwm_duty = 0.0F;
+  if (target > 0.0F) {
+    pwm_duty = pwm_duty_limit;
+  } else if (target < 0.0F) {
+    pwm_duty = -pwm_duty_limit;
+    target = -target;
+  }
+
+  // Called from the main loop, while commit() and the current loop read this
+  // state in the interrupts
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  // Start from no output and let the current loop raise the ceiling up to the
+  // duty cycle giving the target current
+  if (!current_mode_) duty_ceiling_ = 0.0F;
+  setRequestedDuty(pwm_duty);
+  target_current_ = target;
+  current_mode_ = true;
+  __set_PRIMASK(primask);
+}
+
+void MotorController::setRequestedDuty(float pwm_duty) {
   pwm_duty_ = clamp(pwm_duty, 100.0F);
 
-  int16_t power = static_cast<int16_t>((pwm_duty_ / 100.0F) *
-                                       static_cast<float>(PWM_RANGE));
+  int16_t power = static_cast<int16_t>(pwm_duty_ * PWM_DUTY_TO_CCR);
 
   if (config_.reverse_polarity) power *= -1;
 
   if (power >= 0) {
-    gpio_reset(config_.phase);
-    *config_.pwm_ccr = static_cast<uint32_t>(power);
+    phase_ = false;
+    pwm_ccr_value_ = static_cast<uint32_t>(power);
   } else {
-    gpio_set(config_.phase);
-    *config_.pwm_ccr = static_cast<uint32_t>(-power);
+    phase_ = true;
+    pwm_ccr_value_ = static_cast<uint32_t>(-power);
   }
 }
 
@@ -36,26 +82,127 @@ float MotorController::getPWMDutyCycle() {
   return pwm_duty_;
 }
 
-int32_t MotorController::getEncoderCnt() {
-  uint16_t ticks_timer = *config_.enc_cnt;
-  uint8_t ticks_quarter = ticks_timer >> 14;
+void MotorController::updateCurrentLoop() {
+  float limit = current_limit_;
+  if (current_mode_ && (limit <= 0.0F || target_current_ < limit))
+    limit = target_current_;
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  if (!current_mode_ && limit <= 0.0F) {
+    duty_ceiling_ = 100.0F;
+  } else {
+    // Integrate the current error starting from the duty cycle actually
+    // applied, so that the ceiling does not wind up above the request
+    const float applied_duty =
+        static_cast<float>(limitedCcrValue()) / PWM_DUTY_TO_CCR;
+    const float ceiling = applied_duty + CURRENT_LOOP_GAIN *
+                                             (limit - getWindingCurrent());
+    duty_ceiling_ = ceiling < 0.0F ? 0.0F : clamp(ceiling, 100.0F);
+  }
+
+  // Written without the UDIS bracket of MotorBank::commit(), so while the
+  // ceiling limits the duty cycle, the new values of the motors can take
+  // effect on different PWM periods of the two timers
+  if (!fault_) *config_.pwm_ccr = limitedCcrValue();
+  __set_PRIMASK(primask);
+}
+
+uint32_t MotorController::limitedCcrValue() const {
+  if (reversal_hold_) return 0;
+  const uint32_t ceiling =
+      static_cast<uint32_t>(duty_ceiling_ * PWM_DUTY_TO_CCR);
+  return committed_ccr_value_ < ceiling ? committed_ccr_value_ : ceiling;
+}
 
-  if (ticks_prev_quarter_ == 3 && ticks_quarter == 0)
-    ticks_offset_ += (1 << 16);
-  if (ticks_prev_quarter_ == 0 && ticks_quarter == 3)
-    ticks_offset_ -= (1 << 16);
+void MotorController::sampleEncoder() {
+  // The counter is read before the wrap flag, so that a wrap between the two
+  // reads is seen too
+  const uint32_t cnt = config_.enc_tim->CNT;
+  int32_t offset = ticks_offset_;
 
-  ticks_prev_quarter_ = ticks_quarter;
+  // The timer update interrupt cannot preempt this, so a wrap may still be
+  // waiting to be counted
+  if (ticks_wrap_ != 0 && (config_.enc_tim->SR & TIM_SR_UIF)) {
+    config_.enc_tim->SR = ~TIM_SR_UIF;
+    encoderOverflowCallback();
+
+    // Values read after an upward wrap are in the lower half of the range and
+    // after a downward one in the upper half
+    const bool wrapped_up = ticks_offset_ > offset;
+    const bool read_high = cnt >= (1 << 15);
+    if (wrapped_up != read_high) offset = ticks_offset_;
+  }
 
-  int32_t ticks = ticks_offset_ + ticks_timer;
+  int32_t ticks = offset + static_cast<int32_t>(cnt);
   if (config_.reverse_polarity) ticks *= -1;
-  return ticks;
+
+  const uint32_t now = cycles();
+  const uint32_t elapsed = now - edge_time_;
+  if (ticks != edge_ticks_) {
+    if (elapsed > 0) {
+      edge_velocity_ = static_cast<float>(ticks - edge_ticks_) /
+                       static_cast<float>(elapsed);
+    }
+    edge_ticks_ = ticks;
+    edge_time_ = now;
+  } else if (elapsed > ENCODER_EDGE_TIMEOUT * (SystemCoreClock / 1000)) {
+    // No edges for a long time, consider the wheel stopped
+    edge_velocity_ = 0.0F;
+    edge_time_ = now;
+  }
+}
+
+void MotorController::encoderOverflowCallback() {
+  // The counter is just past the wrap, its value tells the direction
+  if (config_.enc_tim->CNT < (1 << 15))
+    ticks_offset_ += ticks_wrap_;
+  else
+    ticks_offset_ -= ticks_wrap_;
+}
+
+void MotorController::faultCallback() {
+  *config_.pwm_ccr = 0;
+  fault_ = true;
+  fault_count_ = fault_count_ + 1;
+  fault_time_ = time();
+}
+
+int32_t MotorController::getEncoderCnt() {
+  return latched_cnt_;
+}
+
+void MotorController::latchEncoderCnt(uint32_t now) {
+  // Extrapolate the position with the speed measured between the last two
+  // edges, but never beyond the next edge which has not been seen yet
+  const float max_fraction = static_cast<float>(ENCODER_SUBTICKS - 1) /
+                             static_cast<float>(ENCODER_SUBTICKS);
+  const float fraction = clamp(
+      edge_velocity_ * static_cast<float>(now - edge_time_), max_fraction);
+
+  // Scaled in unsigned arithmetic, so that the count wraps around cleanly
+  // instead of overflowing ENCODER_SUBTICKS times sooner than the encoder
+  // position. The changes between two latches stay exact across the wrap.
+  const int32_t fraction_subticks =
+      static_cast<int32_t>(fraction * static_cast<float>(ENCODER_SUBTICKS));
+  const uint32_t subticks = static_cast<uint32_t>(edge_ticks_) *
+                                static_cast<uint32_t>(ENCODER_SUBTICKS) +
+                            static_cast<uint32_t>(fraction_subticks);
+  latched_cnt_ = static_cast<int32_t>(subticks);
 }
 
 void MotorController::resetEncoderCnt() {
-  ticks_prev_quarter_ = 0;
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
   ticks_offset_ = 0;
-  *config_.enc_cnt = 0;
+  config_.enc_tim->CNT = 0;
+  config_.enc_tim->SR = ~TIM_SR_UIF;
+  edge_ticks_ = 0;
+  edge_time_ = cycles();
+  edge_velocity_ = 0.0F;
+  latched_cnt_ = 0;
+  __set_PRIMASK(primask);
 }
 
 float MotorController::getWindingCurrent() {
@@ -0,0 +1,109 @@
+#include "firmware/odom_fusion.hpp"
+
+#include <cmath>
+
+static constexpr float PI = 3.141592653F;
+
+static constexpr float SAMPLE_PERIOD =
+    static_cast<float>(ImuReceiver::SAMPLE_PERIOD_US) * 1e-6F;
+
+// Wheel odometry velocities below which the robot is considered stationary
+static constexpr float STATIONARY_LINEAR_VELOCITY = 0.005F;   // m/s
+static constexpr float STATIONARY_ANGULAR_VELOCITY = 0.005F;  // rad/s
+
+// Fraction of the difference between the measured yaw rate and the bias
+// estimate applied per second of standing still
+static constexpr float GYRO_BIAS_RATE = 0.5F;
+
+// Time without gyroscope samples after which the wheel odometry takes over
+static constexpr int32_t GYRO_TIMEOUT_US = 50000;
+
+void OdomFusion::reset() {
+  velocity_lin_x = velocity_lin_y = velocity_ang = 0.0F;
+  pose_x = pose_y = pose_yaw = 0.0F;
+}
+
+void OdomFusion::update(const ImuSample* samples, uint8_t sample_count,
+                        const diff_drive_lib::Odom& odom) {
+  // Skip the samples from the time already covered by the wheel odometry
+  while (sample_count > 0 && time_valid_ &&
+         static_cast<int32_t>(samples[0].time - time_) <= 0) {
+    ++samples;
+    --sample_count;
+  }
+  if (sample_count == 0) return;
+  time_ = samples[sample_count - 1].time;
+  time_valid_ = true;
+  gyro_timed_out_ = false;
+
+  float gyro_sum = 0.0F;
+  for (uint8_t i = 0; i < sample_count; ++i) gyro_sum += samples[i].gz;
+
+  const float dt = static_cast<float>(sample_count) * SAMPLE_PERIOD;
+  const float gyro_mean = gyro_sum / static_cast<float>(sample_count);
+
+  const bool stationary =
+      std::fabs(odom.velocity_lin_x) < STATIONARY_LINEAR_VELOCITY &&
+      std::fabs(odom.velocity_lin_y) < STATIONARY_LINEAR_VELOCITY &&
+      std::fabs(odom.velocity_ang) < STATIONARY_ANGULAR_VELOCITY;
+
+  velocity_lin_x = odom.velocity_lin_x;
+  velocity_lin_y = odom.velocity_lin_y;
+
+  if (stationary) {
+    // The wheels say the true yaw rate is zero, so whatever the gyroscope
+    // measures is bias
+    gyro_bias_ += (gyro_mean - gyro_bias_) * GYRO_BIAS_RATE * dt;
+    velocity_ang = 0.0F;
+    return;
+  }
+
+  // Summing the samples integrates the yaw rate at the sensor rate
+  velocity_ang = gyro_mean - gyro_bias_;
+  const float heading_change =
+      (gyro_sum - gyro_bias_ * static_cast<float>(sample_count)) *
+      SAMPLE_PERIOD;
+
+  advance(heading_change, dt);
+}
+
+void OdomFusion::updateWheels(const diff_drive_lib::Odom& odom,
+                              uint32_t time_us) {
+  if (!time_valid_) {
+    time_ = time_us;
+    time_valid_ = true;
+    return;
+  }
+
+  // Once timed out, the estimate follows the wheels on every tick until the
+  // gyroscope samples come back
+  const int32_t elapsed = static_cast<int32_t>(time_us - time_);
+  if (elapsed <= 0) return;
+  if (!gyro_timed_out_) {
+    if (elapsed < GYRO_TIMEOUT_US) return;
+    gyro_timed_out_ = true;
+  }
+  time_ = time_us;
+
+  const float dt = static_cast<float>(elapsed) * 1e-6F;
+  velocity_lin_x = odom.velocity_lin_x;
+  velocity_lin_y = odom.velocity_lin_y;
+  velocity_ang = odom.velocity_ang;
+  advance(velocity_ang * dt, dt);
+}
+
+void OdomFusion::advance(float heading_change, float dt) {
+  // Move along the heading from the middle of the interval
+  const float heading = pose_yaw + heading_change * 0.5F;
+  const float cos_heading = std::cos(heading);
+  const float sin_heading = std::sin(heading);
+  pose_x += (velocity_lin_x * cos_heading - velocity_lin_y * sin_heading) * dt;
+  pose_y += (velocity_lin_x * sin_heading + velocity_lin_y * cos_heading) * dt;
+
+  pose_yaw += heading_change;
+  if (pose_yaw > PI) {
+    pose_yaw -= 2.0F * PI;
+  } else if (pose_yaw <= -PI) {
+    pose_yaw += 2.0F * PI;
+  }
+}
@@ -1,44 +1,232 @@
-#include <string>
-
 #include "firmware/parameters.hpp"
 
+#include <cstring>
+
+#include "firmware/configuration.hpp"
+
 static constexpr int TIMEOUT = 1000;
 
+// The current sense saturates above its range, so a higher limit would never
+// be reached
+static float measurableCurrentLimit(float limit) {
+  return limit < CURRENT_SENSE_RANGE ? limit : CURRENT_SENSE_RANGE;
+}
+
 void Parameters::load(ros::NodeHandle &nh) {
-  nh.getParam("firmware/mecanum_wheels", &mecanum_wheels, 1, TIMEOUT);
-  if (mecanum_wheels) {
-    robot_wheel_radius = 0.0635F;
-    robot_wheel_separation = 0.37F;
-    robot_angular_velocity_multiplier = 1.0F;
-    nh.getParam("firmware/mecanum_drive/wheel_radius", &robot_wheel_radius, 1,
-                TIMEOUT);
-    nh.getParam("firmware/mecanum_drive/wheel_separation",
-                &robot_wheel_separation, 1, TIMEOUT);
-    nh.getParam("firmware/mecanum_drive/wheel_base", &robot_wheel_base, 1,
-                TIMEOUT);
-    nh.getParam("firmware/mecanum_drive/angular_velocity_multiplier",
-                &robot_angular_velocity_multiplier, 1, TIMEOUT);
-    nh.getParam("firmware/mecanum_drive/input_timeout", &robot_input_timeout, 1,
-                TIMEOUT);
-  } else {
-    nh.getParam("firmware/diff_drive/wheel_radius", &robot_wheel_radius, 1,
-                TIMEOUT);
-    nh.getParam("firmware/diff_drive/wheel_separation", &robot_wheel_separation,
-                1, TIMEOUT);
-    nh.getParam("firmware/diff_drive/angular_velocity_multiplier",
-                &robot_angular_velocity_multiplier, 1, TIMEOUT);
-    nh.getParam("firmware/diff_drive/input_timeout", &robot_input_timeout, 1,
-                TIMEOUT);
+  for (uint8_t index = 0; index < COUNT; ++index) load(nh, index, TIMEOUT);
+}
+
+bool Parameters::load(ros::NodeHandle &nh, uint8_t index, int timeout) {
+  const auto get = [&](const char *name, auto *param) {
+    return nh.getParam(name, param, 1, timeout);
+  };
+  const bool mecanum = mecanumWheels();
+
+  switch (index) {
+    case 0:
+#if !defined(FIRMWARE_DRIVE_DIFF) && !defined(FIRMWARE_DRIVE_MECANUM)
+      if (!get("firmware/mecanum_wheels", &mecanum_wheels)) return false;
+#endif
+      // Defaults of the mecanum drive geometry
+      if (mecanumWheels()) {
+        robot_wheel_radius = 0.0635F;
+        robot_wheel_separation = 0.37F;
+        robot_angular_velocity_multiplier = 1.0F;
+      }
+      return true;
+    case 1:
+      return get(mecanum ? "firmware/mecanum_drive/wheel_radius"
+                         : "firmware/diff_drive/wheel_radius",
+                 &robot_wheel_radius);
+    case 2:
+      return get(mecanum ? "firmware/mecanum_drive/wheel_separation"
+                         : "firmware/diff_drive/wheel_separation",
+                 &robot_wheel_separation);
+    case 3:
+      // Only the mecanum drive uses the wheel base
+      if (!mecanum) return true;
+      return get("firmware/mecanum_drive/wheel_base", &robot_wheel_base);
+    case 4:
+      return get(mecanum ? "firmware/mecanum_drive/angular_velocity_multiplier"
+                         : "firmware/diff_drive/angular_velocity_multiplier",
+                 &robot_angular_velocity_multiplier);
+    case 5:
+      return get(mecanum ? "firmware/mecanum_drive/input_timeout"
+                         : "firmware/diff_drive/input_timeout",
+                 &robot_input_timeout);
+    case 6:
+      return get("firmware/wheels/encoder_resolution",
+                 &wheel_encoder_resolution);
+    case 7:
+      return get("firmware/wheels/torque_constant", &wheel_torque_constant);
+    case 8:
+      return get("firmware/wheels/pid/p", &wheel_pid_p);
+    case 9:
+      return get("firmware/wheels/pid/i", &wheel_pid_i);
+    case 10:
+      return get("firmware/wheels/pid/d", &wheel_pid_d);
+    case 11:
+      return get("firmware/wheels/pwm_duty_limit", &wheel_pwm_duty_limit);
+    case 12:
+      if (!get("firmware/wheels/current_limit", &wheel_current_limit))
+        return false;
+      wheel_current_limit = measurableCurrentLimit(wheel_current_limit);
+      return true;
+    case 13:
+      return get("firmware/battery_min_voltage", &battery_min_voltage);
+    case 14:
+      return get("firmware/control_frequency", &control_frequency);
+    case 15:
+      return get("firmware/imu_batch_decimation", &imu_batch_decimation);
+    case 16:
+      return get("firmware/state_frame", &state_frame);
+    case 17:
+      return get("firmware/odom_fusion", &odom_fusion);
+    default:
+      return false;
+  }
+}
+
+void Parameters::load(const leo_msgs::SetParamsRequest &req) {
+  mecanum_wheels = req.mecanum_wheels;
+  robot_wheel_radius = req.wheel_radius;
+  robot_wheel_separation = req.wheel_separation;
+  robot_wheel_base = req.wheel_base;
+  robot_angular_velocity_multiplier = req.angular_velocity_multiplier;
+  robot_input_timeout = req.input_timeout;
+  wheel_encoder_resolution = req.encoder_resolution;
+  wheel_torque_constant = req.torque_constant;
+  wheel_pid_p = req.pid_p;
+  wheel_pid_i = req.pid_i;
+  wheel_pid_d = req.pid_d;
+  wheel_pwm_duty_limit = req.pwm_duty_limit;
+  wheel_current_limit = measurableCurrentLimit(req.current_limit);
+  battery_min_voltage = req.battery_min_voltage;
+  control_frequency = req.control_frequency;
+  imu_batch_decimation = req.imu_batch_decimation;
+  state_frame = req.state_frame;
+  odom_fusion = req.odom_fusion;
+}
+
+bool Parameters::needsRestart(const Parameters &other) const {
+  // These select the controller type, the update rate and the topics
+  return mecanumWheels() != other.mecanumWheels() ||
+         control_frequency != other.control_frequency ||
+         imu_batch_decimation != other.imu_batch_decimation ||
+         state_frame != other.state_frame ||
+         odom_fusion != other.odom_fusion;
+}
+
+// Parameter sets are appended to the flash sector one after another, so that
+// the sector, whose erase stalls the CPU for over a second, only has to be
+// erased once it is full. Each record starts with the magic number, written
+// first, and ends with the CRC, written last, so a record interrupted by
+// a power loss is skipped.
+struct ParameterRecord {
+  uint32_t magic;
+  Parameters params;
+  uint32_t crc;
+};
+
+// Has to be changed whenever the layout of the Parameters struct changes
+static constexpr uint32_t RECORD_MAGIC = 0x50415203;
+static constexpr uint32_t ERASED_WORD = 0xFFFFFFFF;
+static constexpr uint32_t RECORD_WORDS =
+    sizeof(ParameterRecord) / sizeof(uint32_t);
+static constexpr uint32_t MAX_RECORDS =
+    PARAMS_FLASH_SIZE / sizeof(ParameterRecord);
+
+static_assert(sizeof(ParameterRecord) % sizeof(uint32_t) == 0,
+              "The record has to be programmed in whole words");
+
+static const ParameterRecord *const records =
+    reinterpret_cast<const ParameterRecord *>(PARAMS_FLASH_ADDRESS);
+
+static uint32_t crc32(const void *data, size_t size) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < size; ++i) {
+    crc ^= bytes[i];
+    for (uint8_t bit = 0; bit < 8; ++bit)
+      crc = (crc >> 1) ^ (0xEDB88320 & (0U - (crc & 1U)));
+  }
+  return ~crc;
+}
+
+// Returns the number of records in the sector or MAX_RECORDS + 1 if the sector
+// holds data in an unknown format
+static uint32_t countRecords() {
+  uint32_t count = 0;
+  while (count < MAX_RECORDS && records[count].magic != ERASED_WORD) {
+    if (records[count].magic != RECORD_MAGIC) return MAX_RECORDS + 1;
+    ++count;
+  }
+  return count;
+}
+
+static const Parameters *lastCachedParameters() {
+  uint32_t count = countRecords();
+  if (count > MAX_RECORDS) return nullptr;
+
+  while (count > 0) {
+    const ParameterRecord &record = records[--count];
+    if (record.crc == crc32(&record.params, sizeof(record.params)))
+      return &record.params;
+  }
+  return nullptr;
+}
+
+bool Parameters::loadCached() {
+  const Parameters *cached = lastCachedParameters();
+  if (cached == nullptr) return false;
+  std::memcpy(static_cast<void *>(this), cached, sizeof(Parameters));
+  return true;
+}
+
+static bool isCached(const Parameters &params) {
+  const Parameters *cached = lastCachedParameters();
+  return cached != nullptr &&
+         std::memcmp(cached, &params, sizeof(Parameters)) == 0;
+}
+
+bool Parameters::saveNeedsErase() const {
+  return !isCached(*this) && countRecords() >= MAX_RECORDS;
+}
+
+bool Parameters::saveCached() const {
+  if (isCached(*this)) return false;
+
+  ParameterRecord record;
+  record.magic = RECORD_MAGIC;
+  std::memcpy(static_cast<void *>(&record.params), this, sizeof(Parameters));
+  record.crc = crc32(&record.params, sizeof(record.params));
+
+  HAL_FLASH_Unlock();
+
+  uint32_t count = countRecords();
+  if (count >= MAX_RECORDS) {
+    FLASH_EraseInitTypeDef erase = {};
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Sector = PARAMS_FLASH_SECTOR;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    uint32_t sector_error;
+    if (HAL_FLASHEx_Erase(&erase, &sector_error) != HAL_OK) {
+      HAL_FLASH_Lock();
+      return false;
+    }
+    count = 0;
+  }
+
+  const uint32_t *words = reinterpret_cast<const uint32_t *>(&record);
+  const uint32_t address =
+      PARAMS_FLASH_ADDRESS + count * sizeof(ParameterRecord);
+  bool success = true;
+  for (uint32_t i = 0; i < RECORD_WORDS && success; ++i) {
+    success = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i * 4,
+                                words[i]) == HAL_OK;
   }
 
-  nh.getParam("firmware/wheels/encoder_resolution", &wheel_encoder_resolution,
-              1, TIMEOUT);
-  nh.getParam("firmware/wheels/torque_constant", &wheel_torque_constant, 1,
-              TIMEOUT);
-  nh.getParam("firmware/wheels/pid/p", &wheel_pid_p, 1, TIMEOUT);
-  nh.getParam("firmware/wheels/pid/i", &wheel_pid_i, 1, TIMEOUT);
-  nh.getParam("firmware/wheels/pid/d", &wheel_pid_d, 1, TIMEOUT);
-  nh.getParam("firmware/wheels/pwm_duty_limit", &wheel_pwm_duty_limit, 1,
-              TIMEOUT);
-  nh.getParam("firmware/battery_min_voltage", &battery_min_voltage, 1, TIMEOUT);
+  HAL_FLASH_Lock();
+  return success;
 }
@@ -0,0 +1,75 @@
+#ifdef FIRMWARE_PROFILING
+
+#include <cstdio>
+
+#include "firmware/profiler.hpp"
+
+Profiler profiler;
+
+static const char* stageName(uint8_t stage) {
+  switch (stage) {
+    case PROFILE_UPDATE:
+      return "update";
+    case PROFILE_BATTERY:
+      return "battery";
+    case PROFILE_CONTROLLER:
+      return "controller";
+    case PROFILE_WHEEL_STATES:
+      return "wheel_states";
+    case PROFILE_ODOM:
+      return "odom";
+    case PROFILE_IMU:
+      return "imu";
+    case PROFILE_STATE:
+      return "state";
+    case PROFILE_BLACK_BOX:
+      return "black_box";
+    case PROFILE_SPIN:
+      return "spin";
+    case PROFILE_PUB_BATTERY:
+      return "pub_battery";
+    case PROFILE_PUB_ODOM:
+      return "pub_odom";
+    case PROFILE_PUB_WHEEL_STATES:
+      return "pub_wheel_states";
+    case PROFILE_PUB_IMU:
+      return "pub_imu";
+    case PROFILE_PUB_IMU_BATCH:
+      return "pub_imu_batch";
+    case PROFILE_PUB_STATE:
+      return "pub_state";
+    case PROFILE_PUB_BLACK_BOX:
+      return "pub_black_box";
+    default:
+      return "unknown";
+  }
+}
+
+void Profiler::report(char* buf, size_t size) {
+  ProfileStats stats[PROFILE_STAGE_COUNT];
+
+  // The stages measured in update() can interrupt us at any moment
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const uint32_t overruns = overruns_;
+  for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; ++i) {
+    stats[i] = stats_[i];
+    stats_[i] = ProfileStats();
+  }
+  overruns_ = 0;
+  __set_PRIMASK(primask);
+
+  int len = std::snprintf(buf, size, "overruns=%lu (cycles min/mean/max)",
+                          static_cast<unsigned long>(overruns));
+  for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; ++i) {
+    if (len < 0 || static_cast<size_t>(len) >= size) return;
+    if (stats[i].count == 0) continue;
+    len += std::snprintf(
+        buf + len, size - len, " %s=%lu/%lu/%lu", stageName(i),
+        static_cast<unsigned long>(stats[i].min),
+        static_cast<unsigned long>(stats[i].sum / stats[i].count),
+        static_cast<unsigned long>(stats[i].max));
+  }
+}
+
+#endif
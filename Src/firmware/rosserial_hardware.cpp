@@ -0,0 +1,77 @@
+#include <cstring>
+
+#include "firmware/rosserial_hardware.hpp"
+
+void RosserialHardware::init() {
+  HAL_UART_AbortReceive(huart_);
+  rx_tail_ = 0;
+  HAL_UART_Receive_DMA(huart_, rx_buffer_, RX_BUFFER_SIZE);
+  __HAL_UART_ENABLE_IT(huart_, UART_IT_IDLE);
+
+  // A transfer aborted together with the UART will never complete
+  if (huart_->gState == HAL_UART_STATE_READY) tx_busy_ = false;
+}
+
+int RosserialHardware::read() {
+  const uint16_t head =
+      (RX_BUFFER_SIZE - __HAL_DMA_GET_COUNTER(huart_->hdmarx)) %
+      RX_BUFFER_SIZE;
+  if (rx_tail_ == head) return -1;
+
+  const int data = rx_buffer_[rx_tail_];
+  rx_tail_ = (rx_tail_ + 1) % RX_BUFFER_SIZE;
+  return data;
+}
+
+void RosserialHardware::write(const uint8_t *data, int length) {
+  while (length > 0) {
+    // Wait for the running transfer to hand over the other buffer
+    while (tx_fill_length_ == TX_BUFFER_SIZE) continue;
+
+    // Reserve the fill buffer, so that the transfer complete interrupt does
+    // not start sending it while the data is being copied
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    tx_writing_ = true;
+    const uint8_t idx = tx_fill_idx_;
+    const uint16_t offset = tx_fill_length_;
+    __set_PRIMASK(primask);
+
+    uint16_t chunk = TX_BUFFER_SIZE - offset;
+    if (chunk > length) chunk = length;
+    std::memcpy(&tx_buffers_[idx][offset], data, chunk);
+
+    __disable_irq();
+    tx_fill_length_ = offset + chunk;
+    tx_writing_ = false;
+    if (!tx_busy_ && !startTransfer() && tx_fill_length_ == TX_BUFFER_SIZE) {
+      // The UART does not accept transfers, drop the data instead of waiting
+      // for the buffer to be freed
+      tx_fill_length_ = 0;
+    }
+    __set_PRIMASK(primask);
+
+    data += chunk;
+    length -= chunk;
+  }
+}
+
+void RosserialHardware::TxCpltCallback() {
+  tx_busy_ = false;
+  // A buffer being written is sent by write() once the data is in
+  if (!tx_writing_) startTransfer();
+}
+
+bool RosserialHardware::startTransfer() {
+  if (tx_fill_length_ == 0) return false;
+
+  if (HAL_UART_Transmit_DMA(huart_, tx_buffers_[tx_fill_idx_],
+                            tx_fill_length_) != HAL_OK) {
+    return false;
+  }
+
+  tx_busy_ = true;
+  tx_fill_idx_ ^= 1;
+  tx_fill_length_ = 0;
+  return true;
+}
@@ -48,7 +48,8 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-volatile uint16_t adc_buff[5];
+volatile uint16_t adc_buff[ADC_CHANNELS];
+volatile uint16_t adc_dma_buff[ADC_DMA_BUFFER_SIZE];
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -104,6 +105,7 @@ int main(void)
   /* USER CODE BEGIN 2 */
   HAL_TIM_PWM_Start(&htim1, TIM_CHANNEL_1);
   HAL_TIM_PWM_Start(&htim1, TIM_CHANNEL_4);
+  HAL_TIM_PWM_Start(&htim1, TIM_CHANNEL_2);
   HAL_TIM_PWM_Start(&htim9, TIM_CHANNEL_1);
   HAL_TIM_PWM_Start(&htim9, TIM_CHANNEL_2);
 
@@ -112,8 +114,15 @@ int main(void)
   HAL_TIM_Encoder_Start(&htim4, TIM_CHANNEL_ALL);
   HAL_TIM_Encoder_Start(&htim5, TIM_CHANNEL_ALL);
 
+  // TIM2 and TIM5 are 32-bit, the wraps of the 16-bit encoder counters are
+  // counted in the update interrupts
+  __HAL_TIM_CLEAR_FLAG(&htim3, TIM_FLAG_UPDATE);
+  __HAL_TIM_ENABLE_IT(&htim3, TIM_IT_UPDATE);
+  __HAL_TIM_CLEAR_FLAG(&htim4, TIM_FLAG_UPDATE);
+  __HAL_TIM_ENABLE_IT(&htim4, TIM_IT_UPDATE);
+
   HAL_TIM_Base_Start_IT(&htim11);
-  HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adc_buff, 5);
+  HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adc_dma_buff, ADC_DMA_BUFFER_SIZE);
 
   setup();
   /* USER CODE END 2 */
@@ -177,6 +186,8 @@ void SystemClock_Config(void)
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
   if (htim->Instance == TIM11) {
     update();
+  } else if (htim->Instance == TIM3 || htim->Instance == TIM4) {
+    encoderOverflowCallback(htim->Instance);
   }
 }
 /* USER CODE END 4 */